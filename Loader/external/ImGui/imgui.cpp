@@ -3731,6 +3731,11 @@ void ImGui::Shutdown()
     }
     g.IO.Fonts = NULL;
     g.DrawListSharedData.TempBuffer.clear();
+    for (int n = 0; n < IM_ARRAYSIZE(g.DrawListSharedData.ShapeCache); n++)
+    {
+        g.DrawListSharedData.ShapeCache[n].Key = 0;
+        g.DrawListSharedData.ShapeCache[n].Points.clear();
+    }
 
     // Cleanup of other data are conditional on actually having initialized Dear ImGui.
     if (!g.Initialized)
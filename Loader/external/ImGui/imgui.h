@@ -167,6 +167,7 @@ struct ImFontAtlas;                 // Runtime data for multiple fonts, bake mul
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
+struct ImFontHotGlyph;              // Copy of the ImFontGlyph fields read by the text loops, stored per code point in ImFont::HotGlyphs
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
@@ -2974,6 +2975,18 @@ struct ImFontGlyph
     float           U0, V0, U1, V1;     // Texture coordinates
 };
 
+// What CalcTextSizeA()/RenderText() read of an ImFontGlyph, in one contiguous 40-byte record: ImFont::HotGlyphs[c] is the glyph itself, not an index into Glyphs.
+struct ImFontHotGlyph
+{
+    float           AdvanceX;
+    float           X0, Y0, X1, Y1;
+    float           U0, V0, U1, V1;
+    unsigned int    Colored : 1;
+    unsigned int    Visible : 1;
+
+    inline void     Set(const ImFontGlyph& g)   { AdvanceX = g.AdvanceX; X0 = g.X0; Y0 = g.Y0; X1 = g.X1; Y1 = g.Y1; U0 = g.U0; V0 = g.V0; U1 = g.U1; V1 = g.V1; Colored = g.Colored; Visible = g.Visible; }
+};
+
 // Helper to build glyph ranges from text/string data. Feed your application strings/characters to it then call BuildRanges().
 // This is essentially a tightly packed of vector of 64k booleans = 8KB storage.
 struct ImFontGlyphRangesBuilder
@@ -3144,6 +3157,7 @@ struct ImFont
     ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Sparse. Index glyphs by Unicode code-point.
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out //            // All glyphs.
     const ImFontGlyph*          FallbackGlyph;      // 4-8   // out // = FindGlyph(FontFallbackChar)
+    ImVector<ImFontHotGlyph>    HotGlyphs;          // 12-16 // out //            // Dense. Copy of FindGlyph(c) for every c < HotGlyphs.Size (ASCII to Latin Extended-A), read by CalcTextSizeA/RenderText.
 
     // Members: Cold ~32/40 bytes
     ImFontAtlas*                ContainerAtlas;     // 4-8   // out //            // What we has been loaded into
@@ -3178,6 +3192,7 @@ struct ImFont
 
     // [Internal] Don't use!
     IMGUI_API void              BuildLookupTable();
+    IMGUI_API void              BuildHotGlyphs();
     IMGUI_API void              ClearOutputData();
     IMGUI_API void              GrowIndex(int new_size);
     IMGUI_API void              AddGlyph(const ImFontConfig* src_cfg, ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
@@ -130,8 +130,12 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Glyph rasterization on font build worker threads passes a non-NULL userdata and goes straight to the CRT:
+// the ImGui allocator hooks and the debug allocation counters behind IM_ALLOC() aren't thread-safe.
+static void*        ImStbttAlloc(size_t size, void* user_data)  { return user_data ? malloc(size) : IM_ALLOC(size); }
+static void         ImStbttFree(void* ptr, void* user_data)     { if (user_data) free(ptr); else IM_FREE(ptr); }
+#define STBTT_malloc(x,u)   ImStbttAlloc(x,u)
+#define STBTT_free(x,u)     ImStbttFree(x,u)
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -707,6 +711,113 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+bool GImDrawListSimdPaths = true;
+
+// Normal (dy, -dx) of the segments points[i] -> points[i + 1] for i < count, the one starting at the last point wraps to points[0].
+// IM_NORMALIZE2F_OVER_ZERO on 4 segments at a time: _mm_rsqrt_ps gives the same estimate per lane as the _mm_rsqrt_ss of ImRsqrt().
+static void ImDrawList_SegmentNormals(const ImVec2* points, const int points_count, const int count, ImVec2* normals)
+{
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+    if (GImDrawListSimdPaths)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        for (; i1 + 4 < points_count && i1 + 4 <= count; i1 += 4)
+        {
+            // x0 y0 x1 y1 | x2 y2 x3 y3, from i1 and from i1 + 1
+            const __m128 a01 = _mm_loadu_ps(&points[i1].x);
+            const __m128 a23 = _mm_loadu_ps(&points[i1 + 2].x);
+            const __m128 b01 = _mm_loadu_ps(&points[i1 + 1].x);
+            const __m128 b23 = _mm_loadu_ps(&points[i1 + 3].x);
+            __m128 dx = _mm_sub_ps(_mm_shuffle_ps(b01, b23, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128 dy = _mm_sub_ps(_mm_shuffle_ps(b01, b23, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(3, 1, 3, 1)));
+            const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const __m128 inv_len = _mm_rsqrt_ps(d2);
+            const __m128 valid = _mm_cmpgt_ps(d2, zero);
+            dx = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(dx, inv_len)), _mm_andnot_ps(valid, dx));
+            dy = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(dy, inv_len)), _mm_andnot_ps(valid, dy));
+            const __m128 neg_dx = _mm_xor_ps(dx, sign);
+            _mm_storeu_ps(&normals[i1].x, _mm_unpacklo_ps(dy, neg_dx));
+            _mm_storeu_ps(&normals[i1 + 2].x, _mm_unpackhi_ps(dy, neg_dx));
+        }
+    }
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        normals[i1].x = dy;
+        normals[i1].y = -dx;
+    }
+}
+
+// out[i * scales_count + n] = points[i] + dm * scales[n], with dm the average of the normals of the segments ending and starting
+// at points[i] after IM_FIXNORMAL2F. Point 0 is only done when closed (its previous normal is the last one). 4 points at a time,
+// a - b * s written as a + b * -s gives the same float.
+static void ImDrawList_OffsetPoints(const ImVec2* points, const ImVec2* normals, const int points_count, bool closed, const float* scales, const int scales_count, ImVec2* out)
+{
+    int i = 1;
+#ifdef IMGUI_ENABLE_SSE
+    if (GImDrawListSimdPaths)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 min_d2 = _mm_set1_ps(0.000001f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+        for (; i + 4 <= points_count; i += 4)
+        {
+            const __m128 n0_01 = _mm_loadu_ps(&normals[i - 1].x);
+            const __m128 n0_23 = _mm_loadu_ps(&normals[i + 1].x);
+            const __m128 n1_01 = _mm_loadu_ps(&normals[i].x);
+            const __m128 n1_23 = _mm_loadu_ps(&normals[i + 2].x);
+            __m128 dm_x = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(n0_01, n0_23, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(n1_01, n1_23, _MM_SHUFFLE(2, 0, 2, 0))), half);
+            __m128 dm_y = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(n0_01, n0_23, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(n1_01, n1_23, _MM_SHUFFLE(3, 1, 3, 1))), half);
+            const __m128 d2 = _mm_add_ps(_mm_mul_ps(dm_x, dm_x), _mm_mul_ps(dm_y, dm_y));
+            const __m128 valid = _mm_cmpgt_ps(d2, min_d2);
+            const __m128 inv_len2 = _mm_min_ps(_mm_div_ps(one, d2), max_inv_len2);
+            dm_x = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(dm_x, inv_len2)), _mm_andnot_ps(valid, dm_x));
+            dm_y = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(dm_y, inv_len2)), _mm_andnot_ps(valid, dm_y));
+
+            const __m128 p01 = _mm_loadu_ps(&points[i].x);
+            const __m128 p23 = _mm_loadu_ps(&points[i + 2].x);
+            const __m128 p_x = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 p_y = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+            ImVec2* dst = out + i * scales_count;
+            for (int n = 0; n < scales_count; n++)
+            {
+                const __m128 scale = _mm_set1_ps(scales[n]);
+                const __m128 o_x = _mm_add_ps(p_x, _mm_mul_ps(dm_x, scale));
+                const __m128 o_y = _mm_add_ps(p_y, _mm_mul_ps(dm_y, scale));
+                const __m128 o01 = _mm_unpacklo_ps(o_x, o_y);
+                const __m128 o23 = _mm_unpackhi_ps(o_x, o_y);
+                _mm_storel_pi((__m64*)&dst[n], o01);
+                _mm_storeh_pi((__m64*)&dst[scales_count + n], o01);
+                _mm_storel_pi((__m64*)&dst[scales_count * 2 + n], o23);
+                _mm_storeh_pi((__m64*)&dst[scales_count * 3 + n], o23);
+            }
+        }
+    }
+#endif
+    for (; i <= points_count; i++)
+    {
+        if (i == points_count && !closed)
+            break;
+        const int i1 = (i == points_count) ? 0 : i;
+        const int i0 = (i1 == 0) ? points_count - 1 : i1 - 1;
+        float dm_x = (normals[i0].x + normals[i1].x) * 0.5f;
+        float dm_y = (normals[i0].y + normals[i1].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        for (int n = 0; n < scales_count; n++)
+        {
+            out[i1 * scales_count + n].x = points[i1].x + dm_x * scales[n];
+            out[i1 * scales_count + n].y = points[i1].y + dm_y * scales[n];
+        }
+    }
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -749,15 +860,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        ImDrawList_SegmentNormals(points, points_count, count, temp_normals);
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
 
@@ -783,29 +886,16 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Add temporary vertexes for the outer edges: average normals, offset to the outer edge of the AA area.
+            // This writes every point n+1 of a segment n -> n+1, the first point in a closed line being generated from the final one (as n+1 wraps)
+            const float half_draw_scales[2] = { half_draw_size, -half_draw_size };
+            ImDrawList_OffsetPoints(points, temp_normals, points_count, closed, half_draw_scales, 2, temp_points);
+
+            // Generate the indices to form a number of triangles for each line segment
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertexes for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
                 if (use_texture)
                 {
                     // Add indices for two triangles
@@ -879,35 +969,18 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Add temporary vertices: average normals, offset to the outer edges of the AA area and of the solid core.
+            // This writes every point n+1 of a segment n -> n+1, the first point in a closed line being generated from the final one (as n+1 wraps)
+            const float half_outer_thickness = half_inner_thickness + AA_SIZE;
+            const float thick_scales[4] = { half_outer_thickness, half_inner_thickness, -half_inner_thickness, -half_outer_thickness };
+            ImDrawList_OffsetPoints(points, temp_normals, points_count, closed, thick_scales, 4, temp_points);
+
+            // Generate the indices to form a number of triangles for each line segment
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
@@ -992,34 +1065,19 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // Compute normals, then average them into inner and outer fringe points
+        _Data->TempBuffer.reserve_discard(points_count * 3);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        ImVec2* temp_points = temp_normals + points_count;
+        ImDrawList_SegmentNormals(points, points_count, points_count, temp_normals);
+        const float fringe_scales[2] = { -(AA_SIZE * 0.5f), AA_SIZE * 0.5f };
+        ImDrawList_OffsetPoints(points, temp_normals, points_count, true, fringe_scales, 2, temp_points);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = temp_points[i1 * 2 + 0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = temp_points[i1 * 2 + 1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -1387,6 +1445,167 @@ void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDr
     }
 }
 
+bool GImDrawListShapeCache = true;
+
+// Shape cache keys: arc step in bits 0..3, rounded corners in bits 4..7 (the ImDrawFlags_RoundCornersXXX bits), then kind and AA fill.
+#define IM_DRAWLIST_SHAPE_KEY_CIRCLE    (1 << 8)
+#define IM_DRAWLIST_SHAPE_KEY_RECT      (1 << 9)
+#define IM_DRAWLIST_SHAPE_KEY_AA        (1 << 10)
+
+// Rectangle corners in PathRect() order, with their arcs in twelfths of a circle
+static const ImDrawFlags ImDrawListShape_CornerFlags[4] = { ImDrawFlags_RoundCornersTopLeft, ImDrawFlags_RoundCornersTopRight, ImDrawFlags_RoundCornersBottomRight, ImDrawFlags_RoundCornersBottomLeft };
+static const int ImDrawListShape_CornerArcs[4][2] = { { 6, 9 }, { 9, 12 }, { 0, 3 }, { 3, 6 } };
+
+// Tessellates the outline of a cache key at radius 1, through the same _PathArcToFastEx() calls as AddCircleFilled() and PathRect()
+static void ImDrawListShape_Build(ImDrawList* draw_list, ImDrawListShape* shape, ImU32 key)
+{
+    const int a_step = (int)(key & 0x0F);
+    ImVector<ImVec2>& path = draw_list->_Path;
+    IM_ASSERT(path.Size == 0);
+    shape->Key = key;
+    shape->Points.resize(0);
+    if (key & IM_DRAWLIST_SHAPE_KEY_CIRCLE)
+    {
+        draw_list->_PathArcToFastEx(ImVec2(0.0f, 0.0f), 1.0f, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, a_step);
+        path.Size--;
+        for (int i = 0; i < path.Size; i++)
+        {
+            ImDrawListShapePoint point = { path[i], ImVec2(0.0f, 0.0f), 0 };
+            shape->Points.push_back(point);
+        }
+    }
+    else
+    {
+        // Square corners are a single point at the corner itself
+        for (int corner = 0; corner < 4; corner++)
+        {
+            if (key & ImDrawListShape_CornerFlags[corner])
+                draw_list->_PathArcToFastEx(ImVec2(0.0f, 0.0f), 1.0f, ImDrawListShape_CornerArcs[corner][0] * IM_DRAWLIST_ARCFAST_SAMPLE_MAX / 12, ImDrawListShape_CornerArcs[corner][1] * IM_DRAWLIST_ARCFAST_SAMPLE_MAX / 12, a_step);
+            else
+                path.push_back(ImVec2(0.0f, 0.0f));
+            for (int i = shape->Points.Size; i < path.Size; i++)
+            {
+                ImDrawListShapePoint point = { path[i], ImVec2(0.0f, 0.0f), corner };
+                shape->Points.push_back(point);
+            }
+        }
+    }
+    path.Size = 0;
+
+    // Normals of AddConvexPolyFilled(), on a reference outline: circle of radius 1, or corner arcs of radius 1 inside a 4x4 square
+    if (key & IM_DRAWLIST_SHAPE_KEY_AA)
+    {
+        const int points_count = shape->Points.Size;
+        ImDrawListShapePoint* points = shape->Points.Data;
+        draw_list->_Data->TempBuffer.reserve_discard(points_count * 2);
+        ImVec2* ref = draw_list->_Data->TempBuffer.Data;
+        ImVec2* temp_normals = ref + points_count;
+        for (int i = 0; i < points_count; i++)
+        {
+            ref[i] = points[i].Unit;
+            if (key & IM_DRAWLIST_SHAPE_KEY_RECT)
+            {
+                const float offset = (key & ImDrawListShape_CornerFlags[points[i].Corner]) ? 1.0f : 2.0f;
+                ref[i].x += (points[i].Corner == 0 || points[i].Corner == 3) ? -offset : offset;
+                ref[i].y += (points[i].Corner <= 1) ? -offset : offset;
+            }
+        }
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            float dx = ref[i1].x - ref[i0].x;
+            float dy = ref[i1].y - ref[i0].y;
+            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+            temp_normals[i0].x = dy;
+            temp_normals[i0].y = -dx;
+        }
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            const ImVec2& n0 = temp_normals[i0];
+            const ImVec2& n1 = temp_normals[i1];
+            float dm_x = (n0.x + n1.x) * 0.5f;
+            float dm_y = (n0.y + n1.y) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+            points[i1].Normal = ImVec2(dm_x, dm_y);
+        }
+    }
+}
+
+// AddConvexPolyFilled() of a cached outline placed on centres[]/radii[]: same vertex and index layout, points computed the way
+// _PathArcToFastEx() computes them.
+static void ImDrawListShape_Fill(ImDrawList* draw_list, ImU32 key, const ImVec2* centres, const float* radii, ImU32 col)
+{
+    ImDrawListShape* shape = &draw_list->_Data->ShapeCache[((key * 2654435761u) >> 16) % IM_DRAWLIST_SHAPE_CACHE_SIZE];
+    if (shape->Key != key)
+        ImDrawListShape_Build(draw_list, shape, key);
+
+    const ImDrawListShapePoint* points = shape->Points.Data;
+    const int points_count = shape->Points.Size;
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    ImDrawVert* vtx_write = NULL;
+    ImDrawIdx* idx_write = NULL;
+    if (key & IM_DRAWLIST_SHAPE_KEY_AA)
+    {
+        const float AA_SIZE = draw_list->_FringeScale;
+        const float aa_scale = AA_SIZE * 0.5f;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+        const int idx_count = (points_count - 2)*3 + points_count * 6;
+        const int vtx_count = (points_count * 2);
+        draw_list->PrimReserve(idx_count, vtx_count);
+        vtx_write = draw_list->_VtxWritePtr;
+        idx_write = draw_list->_IdxWritePtr;
+
+        const unsigned int vtx_inner_idx = draw_list->_VtxCurrentIdx;
+        const unsigned int vtx_outer_idx = draw_list->_VtxCurrentIdx + 1;
+        for (int i = 2; i < points_count; i++)
+        {
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); idx_write[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+            idx_write += 3;
+        }
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            const ImDrawListShapePoint& point = points[i1];
+            const ImVec2& centre = centres[point.Corner];
+            const float radius = radii[point.Corner];
+            const float x = centre.x + point.Unit.x * radius;
+            const float y = centre.y + point.Unit.y * radius;
+            const float dm_x = point.Normal.x * aa_scale;
+            const float dm_y = point.Normal.y * aa_scale;
+            vtx_write[0].pos.x = (x - dm_x); vtx_write[0].pos.y = (y - dm_y); vtx_write[0].uv = uv; vtx_write[0].col = col;        // Inner
+            vtx_write[1].pos.x = (x + dm_x); vtx_write[1].pos.y = (y + dm_y); vtx_write[1].uv = uv; vtx_write[1].col = col_trans;  // Outer
+            vtx_write += 2;
+
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+            idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); idx_write[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+            idx_write += 6;
+        }
+        draw_list->_VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+    else
+    {
+        const int idx_count = (points_count - 2)*3;
+        const int vtx_count = points_count;
+        draw_list->PrimReserve(idx_count, vtx_count);
+        vtx_write = draw_list->_VtxWritePtr;
+        idx_write = draw_list->_IdxWritePtr;
+        for (int i = 0; i < vtx_count; i++)
+        {
+            const ImDrawListShapePoint& point = points[i];
+            vtx_write[0].pos.x = centres[point.Corner].x + point.Unit.x * radii[point.Corner];
+            vtx_write[0].pos.y = centres[point.Corner].y + point.Unit.y * radii[point.Corner];
+            vtx_write[0].uv = uv; vtx_write[0].col = col;
+            vtx_write++;
+        }
+        for (int i = 2; i < points_count; i++)
+        {
+            idx_write[0] = (ImDrawIdx)(draw_list->_VtxCurrentIdx); idx_write[1] = (ImDrawIdx)(draw_list->_VtxCurrentIdx + i - 1); idx_write[2] = (ImDrawIdx)(draw_list->_VtxCurrentIdx + i);
+            idx_write += 3;
+        }
+        draw_list->_VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+}
+
 void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0)
@@ -1418,6 +1637,32 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
         PrimReserve(6, 4);
         PrimRect(p_min, p_max, col);
     }
+    else if (GImDrawListShapeCache && _Path.Size == 0)
+    {
+        // Same rounding clamp and corner centres as PathRect()
+        flags = FixRectCornerFlags(flags);
+        rounding = ImMin(rounding, ImFabs(p_max.x - p_min.x) * (((flags & ImDrawFlags_RoundCornersTop) == ImDrawFlags_RoundCornersTop) || ((flags & ImDrawFlags_RoundCornersBottom) == ImDrawFlags_RoundCornersBottom) ? 0.5f : 1.0f) - 1.0f);
+        rounding = ImMin(rounding, ImFabs(p_max.y - p_min.y) * (((flags & ImDrawFlags_RoundCornersLeft) == ImDrawFlags_RoundCornersLeft) || ((flags & ImDrawFlags_RoundCornersRight) == ImDrawFlags_RoundCornersRight) ? 0.5f : 1.0f) - 1.0f);
+        if (rounding < 0.5f)
+        {
+            PathRect(p_min, p_max, rounding, flags);
+            PathFillConvex(col);
+            return;
+        }
+        float radii[4];
+        for (int corner = 0; corner < 4; corner++)
+            radii[corner] = (flags & ImDrawListShape_CornerFlags[corner]) ? rounding : 0.0f;
+        const ImVec2 centres[4] =
+        {
+            ImVec2(p_min.x + radii[0], p_min.y + radii[0]),
+            ImVec2(p_max.x - radii[1], p_min.y + radii[1]),
+            ImVec2(p_max.x - radii[2], p_max.y - radii[2]),
+            ImVec2(p_min.x + radii[3], p_max.y - radii[3]),
+        };
+        const int a_step = ImClamp(IM_DRAWLIST_ARCFAST_SAMPLE_MAX / _CalcCircleAutoSegmentCount(rounding), 1, IM_DRAWLIST_ARCFAST_TABLE_SIZE / 4);
+        const ImU32 key = IM_DRAWLIST_SHAPE_KEY_RECT | ((Flags & ImDrawListFlags_AntiAliasedFill) ? IM_DRAWLIST_SHAPE_KEY_AA : 0) | (flags & ImDrawFlags_RoundCornersAll) | a_step;
+        ImDrawListShape_Fill(this, key, centres, radii, col);
+    }
     else
     {
         PathRect(p_min, p_max, rounding, flags);
@@ -1516,6 +1761,15 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments <= 0 && GImDrawListShapeCache && _Path.Size == 0)
+    {
+        // Same arc step as _PathArcToFastEx() picks for the radius
+        const int a_step = ImClamp(IM_DRAWLIST_ARCFAST_SAMPLE_MAX / _CalcCircleAutoSegmentCount(radius), 1, IM_DRAWLIST_ARCFAST_TABLE_SIZE / 4);
+        const ImU32 key = IM_DRAWLIST_SHAPE_KEY_CIRCLE | ((Flags & ImDrawListFlags_AntiAliasedFill) ? IM_DRAWLIST_SHAPE_KEY_AA : 0) | a_step;
+        ImDrawListShape_Fill(this, key, &center, &radius, col);
+        return;
+    }
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1954,34 +2208,19 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // Compute normals, then average them into inner and outer fringe points
+        _Data->TempBuffer.reserve_discard(points_count * 3);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        ImVec2* temp_points = temp_normals + points_count;
+        ImDrawList_SegmentNormals(points, points_count, points_count, temp_normals);
+        const float fringe_scales[2] = { -(AA_SIZE * 0.5f), AA_SIZE * 0.5f };
+        ImDrawList_OffsetPoints(points, temp_normals, points_count, true, fringe_scales, 2, temp_points);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = temp_points[i1 * 2 + 0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = temp_points[i1 * 2 + 1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -2753,6 +2992,55 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+ImFontAtlasParallelForFunc GImFontAtlasParallelFor = NULL;
+
+// A slice of one source font's glyphs, rasterized as a unit. Slices only write inside their own packed rects.
+struct ImFontBuildRasterTask
+{
+    int                 SrcIndex;
+    int                 GlyphFirst;
+    int                 GlyphCount;
+};
+
+struct ImFontBuildRasterJob
+{
+    ImFontAtlas*                atlas;
+    const stbtt_pack_context*   spc;
+    ImFontBuildSrcData*         src_tmp_array;
+    const ImFontBuildRasterTask* tasks;
+    bool                        threaded;
+};
+
+static void ImFontAtlasBuildRasterTask(int task_i, void* user_data)
+{
+    const ImFontBuildRasterJob* job = (const ImFontBuildRasterJob*)user_data;
+    const ImFontBuildRasterTask& task = job->tasks[task_i];
+    const ImFontBuildSrcData& src_tmp = job->src_tmp_array[task.SrcIndex];
+    const ImFontConfig& cfg = job->atlas->ConfigData[task.SrcIndex];
+
+    // stbtt_PackFontRangesRenderIntoRects() writes the oversampling into the pack context, so every task works on a copy
+    stbtt_pack_context spc = *job->spc;
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    font_info.userdata = job->threaded ? (void*)job : NULL;
+    stbtt_pack_range range = src_tmp.PackRange;
+    range.array_of_unicode_codepoints = src_tmp.GlyphsList.Data + task.GlyphFirst;
+    range.num_chars = task.GlyphCount;
+    range.chardata_for_range = src_tmp.PackedChars + task.GlyphFirst;
+    stbrp_rect* rects = src_tmp.Rects + task.GlyphFirst;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < task.GlyphCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, job->atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, job->atlas->TexWidth * 1);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2945,27 +3233,33 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Every glyph only writes inside its own packed rect, so the glyphs are cut into slices that can be rasterized
+    // in any order (and on any thread) with a byte-identical result.
+    const int RASTER_TASK_GLYPHS = 32;
+    ImVector<ImFontBuildRasterTask> raster_tasks;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += RASTER_TASK_GLYPHS)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRasterTask task;
+            task.SrcIndex = src_i;
+            task.GlyphFirst = glyph_i;
+            task.GlyphCount = ImMin(RASTER_TASK_GLYPHS, src_tmp_array[src_i].GlyphsCount - glyph_i);
+            raster_tasks.push_back(task);
         }
-        src_tmp.Rects = NULL;
-    }
+    ImFontBuildRasterJob raster_job;
+    raster_job.atlas = atlas;
+    raster_job.spc = &spc;
+    raster_job.src_tmp_array = src_tmp_array.Data;
+    raster_job.tasks = raster_tasks.Data;
+    raster_job.threaded = GImFontAtlasParallelFor != NULL && raster_tasks.Size > 1;
+    if (raster_job.threaded)
+        GImFontAtlasParallelFor(raster_tasks.Size, ImFontAtlasBuildRasterTask, &raster_job);
+    else
+        for (int task_i = 0; task_i < raster_tasks.Size; task_i++)
+            ImFontAtlasBuildRasterTask(task_i, &raster_job);
+    raster_tasks.clear();
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -3558,6 +3852,31 @@ void ImFontGlyphRangesBuilder::BuildRanges(ImVector<ImWchar>* out_ranges)
 // [SECTION] ImFont
 //-----------------------------------------------------------------------------
 
+bool GImFontAsciiFastPath = true;
+
+#ifdef IMGUI_ENABLE_SSE
+// Length of the run of printable ASCII (0x20..0x7F) at s, looking at no more than 16 bytes.
+// Bytes >= 0x80 are negative as signed chars, so one signed compare catches both control bytes and UTF-8.
+static inline int ImTextAsciiRunLength(const char* s, const char* s_end)
+{
+    if (s_end - s < 16)
+    {
+        int n = 0;
+        while (s + n < s_end && (signed char)s[n] >= 32)
+            n++;
+        return n;
+    }
+    const __m128i bytes = _mm_loadu_si128((const __m128i*)(const void*)s);
+    const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmplt_epi8(bytes, _mm_set1_epi8(32)));
+    if (mask == 0)
+        return 16;
+    int n = 0;
+    while (((mask >> n) & 1) == 0)
+        n++;
+    return n;
+}
+#endif
+
 ImFont::ImFont()
 {
     FontSize = 0.0f;
@@ -3589,6 +3908,7 @@ void    ImFont::ClearOutputData()
     Glyphs.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    HotGlyphs.clear();
     FallbackGlyph = NULL;
     ContainerAtlas = NULL;
     DirtyLookupTables = true;
@@ -3615,6 +3935,7 @@ void ImFont::BuildLookupTable()
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    HotGlyphs.clear();
     DirtyLookupTables = false;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
     GrowIndex(max_codepoint + 1);
@@ -3686,6 +4007,27 @@ void ImFont::BuildLookupTable()
         EllipsisCharStep = (glyph->X1 - glyph->X0) + 1.0f;
         EllipsisWidth = EllipsisCharStep * 3.0f - 1.0f;
     }
+
+    BuildHotGlyphs();
+}
+
+// CalcTextSizeA/RenderText resolve characters below this through HotGlyphs. Covers ASCII, Latin-1 and Latin
+// Extended-A (15KB per font at 40 bytes a record); anything above goes through IndexLookup + Glyphs.
+#define IM_FONT_HOT_GLYPHS_MAX  0x180
+
+// One ImFontHotGlyph per codepoint with the fallback already resolved, so a character is a single record read:
+// no Glyphs index to follow and no -1 test. Missing codepoints hold a copy of the fallback glyph, like FindGlyph()
+// returns. The records are copies, so anything that changes a glyph afterwards (SetGlyphVisible, AddRemapChar)
+// rebuilds the table.
+void ImFont::BuildHotGlyphs()
+{
+    HotGlyphs.resize(0);
+    if (FallbackGlyph == NULL)
+        return;
+    const int count = ImMin(IndexLookup.Size, IM_FONT_HOT_GLYPHS_MAX);
+    HotGlyphs.resize(count);
+    for (int c = 0; c < count; c++)
+        HotGlyphs.Data[c].Set(*FindGlyph((ImWchar)c));
 }
 
 // API is designed this way to avoid exposing the 4K page size
@@ -3705,6 +4047,8 @@ void ImFont::SetGlyphVisible(ImWchar c, bool visible)
 {
     if (ImFontGlyph* glyph = (ImFontGlyph*)(void*)FindGlyph((ImWchar)c))
         glyph->Visible = visible ? 1 : 0;
+    if (HotGlyphs.Size > 0)
+        BuildHotGlyphs();
 }
 
 void ImFont::GrowIndex(int new_size)
@@ -3776,6 +4120,8 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    if (HotGlyphs.Size > 0)
+        BuildHotGlyphs();
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
@@ -3922,10 +4268,35 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+#ifdef IMGUI_ENABLE_SSE
+    const ImFontHotGlyph* hot_glyphs = HotGlyphs.Data;
+    const bool ascii_fast_path = GImFontAsciiFastPath && !word_wrap_enabled && HotGlyphs.Size >= 0x80;
+#endif
 
     const char* s = text_begin;
     while (s < text_end)
     {
+#ifdef IMGUI_ENABLE_SSE
+        // Printable ASCII needs neither UTF-8 decoding nor the '\n'/'\r' checks: sum the advances straight from
+        // the hot records. Same additions in the same order as the loop below, so the result is bit-identical.
+        if (ascii_fast_path)
+        {
+            const int run = ImTextAsciiRunLength(s, text_end);
+            int n = 0;
+            for (; n < run; n++)
+            {
+                const float char_width = hot_glyphs[(unsigned char)s[n]].AdvanceX * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            s += n;
+            if (n < run)
+                break;
+            if (run > 0)
+                continue;
+        }
+#endif
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
@@ -4069,8 +4440,51 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
 
+    // Inside [s, ascii_run_end) every byte is printable ASCII: no UTF-8 decoding, no control characters,
+    // and the glyph comes straight out of HotGlyphs instead of a FindGlyph() call.
+    const ImFontHotGlyph* hot_glyphs = HotGlyphs.Data;
+    const unsigned int hot_glyphs_count = (unsigned int)HotGlyphs.Size;
+    ImFontHotGlyph cold_glyph; // Characters past HotGlyphs are copied here so both paths share one record type
+    const char* ascii_run_end = s;
+#ifdef IMGUI_ENABLE_SSE
+    const bool ascii_fast_path = GImFontAsciiFastPath && !word_wrap_enabled && !cpu_fine_clip && hot_glyphs_count >= 0x80;
+#endif
+
     while (s < text_end)
     {
+#ifdef IMGUI_ENABLE_SSE
+        if (ascii_fast_path && s >= ascii_run_end)
+            ascii_run_end = s + ImTextAsciiRunLength(s, text_end);
+#endif
+        if (s < ascii_run_end)
+        {
+            const ImFontHotGlyph* glyph = &hot_glyphs[(unsigned char)*s++];
+            const float char_width = glyph->AdvanceX * scale;
+            if (glyph->Visible)
+            {
+                const float x1 = x + glyph->X0 * scale;
+                const float x2 = x + glyph->X1 * scale;
+                if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                {
+                    const float y1 = y + glyph->Y0 * scale;
+                    const float y2 = y + glyph->Y1 * scale;
+                    const float u1 = glyph->U0, v1 = glyph->V0, u2 = glyph->U1, v2 = glyph->V1;
+                    const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+                    idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+                    vtx_write += 4;
+                    vtx_index += 4;
+                    idx_write += 6;
+                }
+            }
+            x += char_width;
+            continue;
+        }
+
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
@@ -4110,8 +4524,12 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
                 continue;
         }
 
-        const ImFontGlyph* glyph = FindGlyph((ImWchar)c);
-        if (glyph == NULL)
+        const ImFontHotGlyph* glyph = &cold_glyph;
+        if (c < hot_glyphs_count)
+            glyph = &hot_glyphs[c];
+        else if (const ImFontGlyph* found = FindGlyph((ImWchar)c))
+            cold_glyph.Set(*found);
+        else
             continue;
 
         float char_width = glyph->AdvanceX * scale;
@@ -0,0 +1,626 @@
+// dear imgui: Renderer Backend for a CPU rasterizer drawing into an RGBA8 buffer in memory
+// See imgui_impl_soft.h
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_soft.h"
+#include "imgui_internal.h"   // ImMin, ImMax, ImSwap
+#include <math.h>       // ceilf, floorf
+#include <string.h>     // memcpy, memset
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMGUI_IMPL_SOFT_SSE2
+#endif
+
+#define IMGUI_IMPL_SOFT_TILE_SIZE   64      // Multiple of 4: a tile row is a whole number of 4 pixel groups
+
+// One triangle after setup, in target pixel space
+struct ImGui_ImplSoft_Triangle
+{
+    float                           X[3], Y[3];         // Vertices relative to DisplayPos, counter-clockwise on screen (positive area)
+    float                           EdgeX[3], EdgeY[3]; // Edge i is opposite vertex i and runs from vertex i+1 to i+2
+    float                           Col[3][4];          // Vertex colors (0..255) divided by twice the area: color = sum of w[i] * Col[i]. Col[0] is the color itself if FlatColor.
+    float                           U[3], V[3];         // Texture coordinates, divided the same way
+    int                             Owns;               // Bit i: pixel centres exactly on edge i belong to this triangle
+    int                             MinX, MinY;         // Pixels whose centre may be covered, inclusive, clipped to the scissor rect
+    int                             MaxX, MaxY;
+    bool                            FlatColor;          // Same color on all three vertices
+    bool                            Opaque;             // FlatColor, a single texel and full alpha: every covered pixel becomes Pixel
+    const ImGui_ImplSoft_Texture*   Texture;            // nullptr when untextured or all three vertices have the same uv
+    ImU32                           Texel;              // What every pixel samples when Texture is nullptr
+    ImU32                           Pixel;
+};
+
+// Software renderer data
+struct ImGui_ImplSoft_Data
+{
+    ImGui_ImplSoft_Texture              FontTexture;
+    bool                                FontTextureValid;
+    ImGui_ImplSoft_ParallelForFunc      ParallelFor;
+    ImVector<ImGui_ImplSoft_Triangle>   Triangles;          // Frame's triangles in submission order
+    ImVector<int>                       BinStart;           // Per tile, first entry in BinTriangles (one extra entry at the end)
+    ImVector<int>                       BinTriangles;       // Triangle indices of every tile, one tile after the other
+
+    ImGui_ImplSoft_Data()               { memset((void*)this, 0, sizeof(*this)); }
+};
+
+// What every tile task needs
+struct ImGui_ImplSoft_Job
+{
+    const ImGui_ImplSoft_Data*      Data;
+    const ImGui_ImplSoft_Target*    Target;
+    int                             Width;
+    int                             Height;
+    int                             TilesX;
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+static ImGui_ImplSoft_Data* ImGui_ImplSoft_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoft_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+// Functions
+
+// Narrows [*x0,*x1] to the pixels of row cy that may be inside tri (row[i]: the row's EdgeX * (cy - Ya) term), returns
+// false if there are none. Fan triangles of convex fills are long and thin, their bounds are mostly empty. [*inner_x0,
+// *inner_x1] gets the pixels that are inside for sure (may be empty). Both are widened/narrowed by the rounding the edge
+// functions can have, so they never disagree with the exact per-pixel test.
+static bool ImGui_ImplSoft_RowSpan(const ImGui_ImplSoft_Triangle& tri, const float row[3], int* x0, int* x1, int* inner_x0, int* inner_x1)
+{
+    float lo = (float)*x0, hi = (float)*x1;
+    float inner_lo = lo, inner_hi = hi;
+    for (int i = 0; i < 3; i++)
+    {
+        const float ey = tri.EdgeY[i];
+        if (ey == 0.0f)
+        {
+            if (row[i] < 0.0f)          // Constant along the row, exactly
+                return false;
+            if (row[i] == 0.0f)
+                inner_hi = -1.0f;       // Inside only if the edge owns it, leave that to the per-pixel test
+            continue;
+        }
+        const float xa = tri.X[(i + 1) % 3];
+        const float t = row[i] / ey;
+        const float margin = 2.0f + 1e-5f * (ImFabs(t) + ImFabs(xa) + 16384.0f);
+        if (ey > 0.0f)
+        {
+            hi = ImMin(hi, floorf(xa + t - 0.5f + margin));     // w decreases to the right
+            inner_hi = ImMin(inner_hi, floorf(xa + t - 0.5f - margin));
+        }
+        else
+        {
+            lo = ImMax(lo, ceilf(xa + t - 0.5f - margin));
+            inner_lo = ImMax(inner_lo, ceilf(xa + t - 0.5f + margin));
+        }
+    }
+    if (!(lo <= hi))
+        return false;
+    *x0 = (int)lo;
+    *x1 = (int)hi;
+    *inner_x0 = 0;
+    *inner_x1 = -1;
+    if (inner_lo <= inner_hi)
+    {
+        *inner_x0 = (int)inner_lo;
+        *inner_x1 = (int)inner_hi;
+    }
+    return true;
+}
+
+#ifdef IMGUI_IMPL_SOFT_SSE2
+
+// Draws the part of tri inside [x0,x1]x[y0,y1], 4 pixels at a time. Groups start at multiples of 4, which stay inside
+// the tile: pixels of the group that tri doesn't cover are written back unchanged, never touching another tile's pixels.
+static void ImGui_ImplSoft_DrawTriangle(const ImGui_ImplSoft_Triangle& tri, int x0, int y0, int x1, int y1, const ImGui_ImplSoft_Target* target)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 k255 = _mm_set1_ps(255.0f);
+    const __m128 inv_255 = _mm_set1_ps(1.0f / 255.0f);
+    const __m128 inv_255_sq = _mm_set1_ps(1.0f / (255.0f * 255.0f));
+    const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128i byte_mask = _mm_set1_epi32(0xFF);
+    const __m128i opaque_px = _mm_set1_epi32((int)tri.Pixel);
+
+    __m128 edge_y[3], edge_x0[3], owns[3], col[3][4], u[3], v[3];
+    for (int i = 0; i < 3; i++)
+    {
+        edge_y[i] = _mm_set1_ps(tri.EdgeY[i]);
+        edge_x0[i] = _mm_set1_ps(tri.X[(i + 1) % 3]);
+        owns[i] = _mm_castsi128_ps(_mm_set1_epi32((tri.Owns & (1 << i)) ? -1 : 0));
+        for (int c = 0; c < 4; c++)
+            col[i][c] = _mm_set1_ps(tri.Col[i][c]);
+        u[i] = _mm_set1_ps(tri.U[i]);
+        v[i] = _mm_set1_ps(tri.V[i]);
+    }
+
+    const ImGui_ImplSoft_Texture* tex = tri.Texture;
+    const __m128 tex_w = _mm_set1_ps(tex ? (float)tex->Width : 0.0f);
+    const __m128 tex_h = _mm_set1_ps(tex ? (float)tex->Height : 0.0f);
+    const __m128 tex_max_x = _mm_set1_ps(tex ? (float)(tex->Width - 1) : 0.0f);
+    const __m128 tex_max_y = _mm_set1_ps(tex ? (float)(tex->Height - 1) : 0.0f);
+    __m128 texel[4];
+    for (int c = 0; c < 4; c++)
+        texel[c] = _mm_set1_ps((float)((tri.Texel >> (8 * c)) & 0xFF));
+
+    // Solid: one color for the whole triangle, the source side of the blend is computed once. The inner span of a row
+    // then needs no edge test, which is most of the pixels of large fills.
+    const bool opaque = tri.Opaque;
+    const bool solid = tri.FlatColor && !tex;
+    const int target_w = target->Width;
+    const __m128 solid_a = _mm_mul_ps(_mm_mul_ps(col[0][3], texel[3]), inv_255_sq);
+    const __m128 solid_inv_a = _mm_sub_ps(one, solid_a);
+    __m128 solid_src[3];
+    for (int c = 0; c < 3; c++)
+        solid_src[c] = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(col[0][c], texel[c]), inv_255), solid_a);
+
+    for (int py = y0; py <= y1; py++)
+    {
+        // Edge functions w = EdgeX * (cy - Ya) - EdgeY * (cx - Xa): the first product only depends on the row
+        const float cy = (float)py + 0.5f;
+        float row_f[3];
+        __m128 row[3];
+        for (int i = 0; i < 3; i++)
+        {
+            row_f[i] = tri.EdgeX[i] * (cy - tri.Y[(i + 1) % 3]);
+            row[i] = _mm_set1_ps(row_f[i]);
+        }
+        int span_x0 = x0, span_x1 = x1, inner_x0, inner_x1;
+        if (!ImGui_ImplSoft_RowSpan(tri, row_f, &span_x0, &span_x1, &inner_x0, &inner_x1))
+            continue;
+        if (!solid)
+            inner_x1 = -1;
+        ImU32* dst_row = target->Pixels + (size_t)py * target->Pitch;
+
+        for (int px = span_x0 & ~3; px <= span_x1; px += 4)
+        {
+            int mask = 0xF;
+            __m128 w[3] = {}; // Only the edge test fills it; interior spans are solid, which never interpolates
+            if (px < inner_x0 || px + 3 > inner_x1)
+            {
+                const __m128 cx = _mm_add_ps(_mm_add_ps(_mm_set1_ps((float)px), lanes), half);
+                w[0] = _mm_sub_ps(row[0], _mm_mul_ps(edge_y[0], _mm_sub_ps(cx, edge_x0[0])));
+                w[1] = _mm_sub_ps(row[1], _mm_mul_ps(edge_y[1], _mm_sub_ps(cx, edge_x0[1])));
+                w[2] = _mm_sub_ps(row[2], _mm_mul_ps(edge_y[2], _mm_sub_ps(cx, edge_x0[2])));
+                const __m128 in0 = _mm_or_ps(_mm_cmpgt_ps(w[0], zero), _mm_and_ps(_mm_cmpeq_ps(w[0], zero), owns[0]));
+                const __m128 in1 = _mm_or_ps(_mm_cmpgt_ps(w[1], zero), _mm_and_ps(_mm_cmpeq_ps(w[1], zero), owns[1]));
+                const __m128 in2 = _mm_or_ps(_mm_cmpgt_ps(w[2], zero), _mm_and_ps(_mm_cmpeq_ps(w[2], zero), owns[2]));
+                mask = _mm_movemask_ps(_mm_and_ps(_mm_and_ps(in0, in1), in2));
+                if (px < span_x0)
+                    mask &= 0xF << (span_x0 - px);
+                if (px + 3 > span_x1)
+                    mask &= 0xF >> (px + 3 - span_x1);
+                if (mask == 0)
+                    continue;
+            }
+
+            ImU32* dst = dst_row + px;
+            const int count = ImMin(4, target_w - px);
+            if (opaque && mask == 0xF && count == 4)
+            {
+                _mm_storeu_si128((__m128i*)dst, opaque_px);
+                continue;
+            }
+
+            __m128i out = opaque_px;
+            __m128 rgba[4] = {}, src_a = solid_a, inv_a = solid_inv_a; // rgba is only read when !solid
+            if (!solid)
+            {
+                // Interpolation: the per-vertex values are already divided by the area
+                for (int c = 0; c < 4; c++)
+                    rgba[c] = tri.FlatColor ? col[0][c] : _mm_add_ps(_mm_add_ps(_mm_mul_ps(w[0], col[0][c]), _mm_mul_ps(w[1], col[1][c])), _mm_mul_ps(w[2], col[2][c]));
+
+                // Nearest texel. Clamping before the truncation gives the same texel as truncating first.
+                if (tex)
+                {
+                    const __m128 tu = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w[0], u[0]), _mm_mul_ps(w[1], u[1])), _mm_mul_ps(w[2], u[2]));
+                    const __m128 tv = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w[0], v[0]), _mm_mul_ps(w[1], v[1])), _mm_mul_ps(w[2], v[2]));
+                    const __m128i tx = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(tu, tex_w), zero), tex_max_x));
+                    const __m128i ty = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(tv, tex_h), zero), tex_max_y));
+                    int txs[4], tys[4];
+                    _mm_storeu_si128((__m128i*)txs, tx);
+                    _mm_storeu_si128((__m128i*)tys, ty);
+                    ImU32 texels[4];
+                    for (int k = 0; k < 4; k++)
+                        memcpy(&texels[k], tex->Pixels + ((size_t)tys[k] * tex->Width + txs[k]) * 4, sizeof(ImU32));
+                    const __m128i packed = _mm_loadu_si128((const __m128i*)texels);
+                    for (int c = 0; c < 4; c++)
+                        texel[c] = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 8 * c), byte_mask));
+                }
+
+                // A zero source alpha leaves the destination exactly as it was: skip the blend (empty parts of glyphs)
+                src_a = _mm_mul_ps(_mm_mul_ps(rgba[3], texel[3]), inv_255_sq);
+                mask &= _mm_movemask_ps(_mm_cmpneq_ps(src_a, zero));
+                if (mask == 0)
+                    continue;
+                inv_a = _mm_sub_ps(one, src_a);
+            }
+
+            __m128i dst_px;
+            if (count == 4)
+            {
+                dst_px = _mm_loadu_si128((const __m128i*)dst);
+            }
+            else
+            {
+                ImU32 tmp[4] = {};
+                memcpy(tmp, dst, count * sizeof(ImU32));
+                dst_px = _mm_loadu_si128((const __m128i*)tmp);
+            }
+
+            if (!opaque)
+            {
+                out = _mm_setzero_si128();
+                for (int c = 0; c < 3; c++)
+                {
+                    const __m128 src = solid ? solid_src[c] : _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(rgba[c], texel[c]), inv_255), src_a);
+                    const __m128 d = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dst_px, 8 * c), byte_mask));
+                    const __m128 value = _mm_add_ps(src, _mm_mul_ps(d, inv_a));
+                    out = _mm_or_si128(out, _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(value, k255), half)), 8 * c));
+                }
+                const __m128 d_a = _mm_cvtepi32_ps(_mm_srli_epi32(dst_px, 24));
+                const __m128 alpha = _mm_add_ps(_mm_mul_ps(src_a, k255), _mm_mul_ps(d_a, inv_a));
+                out = _mm_or_si128(out, _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(alpha, k255), half)), 24));
+            }
+
+            const __m128i keep = _mm_setr_epi32((mask & 1) ? 0 : -1, (mask & 2) ? 0 : -1, (mask & 4) ? 0 : -1, (mask & 8) ? 0 : -1);
+            out = _mm_or_si128(_mm_andnot_si128(keep, out), _mm_and_si128(keep, dst_px));
+            if (count == 4)
+            {
+                _mm_storeu_si128((__m128i*)dst, out);
+            }
+            else
+            {
+                ImU32 tmp[4];
+                _mm_storeu_si128((__m128i*)tmp, out);
+                memcpy(dst, tmp, count * sizeof(ImU32));
+            }
+        }
+    }
+}
+
+#else
+
+// Same arithmetic one pixel at a time, for targets without SSE2
+static void ImGui_ImplSoft_DrawTriangle(const ImGui_ImplSoft_Triangle& tri, int x0, int y0, int x1, int y1, const ImGui_ImplSoft_Target* target)
+{
+    const ImGui_ImplSoft_Texture* tex = tri.Texture;
+    float texel[4];
+    for (int c = 0; c < 4; c++)
+        texel[c] = (float)((tri.Texel >> (8 * c)) & 0xFF);
+    const bool solid = tri.FlatColor && !tex;
+
+    for (int py = y0; py <= y1; py++)
+    {
+        const float cy = (float)py + 0.5f;
+        float row[3];
+        for (int i = 0; i < 3; i++)
+            row[i] = tri.EdgeX[i] * (cy - tri.Y[(i + 1) % 3]);
+        int span_x0 = x0, span_x1 = x1, inner_x0, inner_x1;
+        if (!ImGui_ImplSoft_RowSpan(tri, row, &span_x0, &span_x1, &inner_x0, &inner_x1))
+            continue;
+        ImU32* dst_row = target->Pixels + (size_t)py * target->Pitch;
+
+        for (int px = span_x0; px <= span_x1; px++)
+        {
+            const float cx = (float)px + 0.5f;
+            float w[3] = {};
+            bool inside = solid && px >= inner_x0 && px <= inner_x1;
+            if (!inside)
+            {
+                inside = true;
+                for (int i = 0; i < 3; i++)
+                {
+                    w[i] = row[i] - tri.EdgeY[i] * (cx - tri.X[(i + 1) % 3]);
+                    inside = inside && (w[i] > 0.0f || (w[i] == 0.0f && (tri.Owns & (1 << i))));
+                }
+            }
+            if (!inside)
+                continue;
+            ImU32& dst = dst_row[px];
+            if (tri.Opaque)
+            {
+                dst = tri.Pixel;
+                continue;
+            }
+
+            float rgba[4];
+            for (int c = 0; c < 4; c++)
+                rgba[c] = tri.FlatColor ? tri.Col[0][c] : w[0] * tri.Col[0][c] + w[1] * tri.Col[1][c] + w[2] * tri.Col[2][c];
+            if (tex)
+            {
+                const float tu = w[0] * tri.U[0] + w[1] * tri.U[1] + w[2] * tri.U[2];
+                const float tv = w[0] * tri.V[0] + w[1] * tri.V[1] + w[2] * tri.V[2];
+                const int tx = ImMin(tex->Width - 1, ImMax(0, (int)(tu * tex->Width)));
+                const int ty = ImMin(tex->Height - 1, ImMax(0, (int)(tv * tex->Height)));
+                const unsigned char* p = tex->Pixels + ((size_t)ty * tex->Width + tx) * 4;
+                for (int c = 0; c < 4; c++)
+                    texel[c] = (float)p[c];
+            }
+
+            const float src_a = rgba[3] * texel[3] * (1.0f / (255.0f * 255.0f));
+            if (src_a == 0.0f)
+                continue;
+            ImU32 out = 0;
+            for (int c = 0; c < 3; c++)
+            {
+                const float value = rgba[c] * texel[c] * (1.0f / 255.0f) * src_a + (float)((dst >> (8 * c)) & 0xFF) * (1.0f - src_a);
+                out |= (ImU32)(ImMin(value, 255.0f) + 0.5f) << (8 * c);
+            }
+            const float alpha = src_a * 255.0f + (float)(dst >> 24) * (1.0f - src_a);
+            dst = out | ((ImU32)(ImMin(alpha, 255.0f) + 0.5f) << 24);
+        }
+    }
+}
+
+#endif // #ifdef IMGUI_IMPL_SOFT_SSE2
+
+static void ImGui_ImplSoft_DrawTile(int tile, void* user_data)
+{
+    const ImGui_ImplSoft_Job* job = (const ImGui_ImplSoft_Job*)user_data;
+    const ImGui_ImplSoft_Data* bd = job->Data;
+    const int tile_x0 = (tile % job->TilesX) * IMGUI_IMPL_SOFT_TILE_SIZE;
+    const int tile_y0 = (tile / job->TilesX) * IMGUI_IMPL_SOFT_TILE_SIZE;
+    const int tile_x1 = ImMin(tile_x0 + IMGUI_IMPL_SOFT_TILE_SIZE, job->Width) - 1;
+    const int tile_y1 = ImMin(tile_y0 + IMGUI_IMPL_SOFT_TILE_SIZE, job->Height) - 1;
+
+    if (job->Target->Clear)
+        for (int y = tile_y0; y <= tile_y1; y++)
+            memset(job->Target->Pixels + (size_t)y * job->Target->Pitch + tile_x0, 0, (size_t)(tile_x1 - tile_x0 + 1) * sizeof(ImU32));
+
+    for (int n = bd->BinStart[tile]; n < bd->BinStart[tile + 1]; n++)
+    {
+        const ImGui_ImplSoft_Triangle& tri = bd->Triangles[bd->BinTriangles[n]];
+        ImGui_ImplSoft_DrawTriangle(tri, ImMax(tri.MinX, tile_x0), ImMax(tri.MinY, tile_y0), ImMin(tri.MaxX, tile_x1), ImMin(tri.MaxY, tile_y1), job->Target);
+    }
+}
+
+// Sets up a triangle, returns false if it can't change any pixel inside the scissor rect
+static bool ImGui_ImplSoft_SetupTriangle(const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImVec2& clip_off, const int scissor[4], const ImGui_ImplSoft_Texture* tex, ImGui_ImplSoft_Triangle* tri)
+{
+    const ImDrawVert* v[3] = { v0, v1, v2 };
+    float x[3], y[3];
+    for (int i = 0; i < 3; i++)
+    {
+        x[i] = v[i]->pos.x - clip_off.x;
+        y[i] = v[i]->pos.y - clip_off.y;
+    }
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0.0f)
+        return false;
+    if (area < 0.0f)
+    {
+        ImSwap(x[1], x[2]);
+        ImSwap(y[1], y[2]);
+        ImSwap(v[1], v[2]);
+        area = -area;
+    }
+
+    tri->MinX = ImMax(scissor[0], (int)ceilf(ImMin(ImMin(x[0], x[1]), x[2]) - 0.5f));
+    tri->MinY = ImMax(scissor[1], (int)ceilf(ImMin(ImMin(y[0], y[1]), y[2]) - 0.5f));
+    tri->MaxX = ImMin(scissor[2] - 1, (int)floorf(ImMax(ImMax(x[0], x[1]), x[2]) - 0.5f));
+    tri->MaxY = ImMin(scissor[3] - 1, (int)floorf(ImMax(ImMax(y[0], y[1]), y[2]) - 0.5f));
+    if (tri->MinX > tri->MaxX || tri->MinY > tri->MaxY)
+        return false;
+
+    // Attributes that are the same on all three vertices are used as they are, without interpolation: flat colors
+    // (everything but anti-aliased fringes and gradients) and the white pixel's uv (everything but text and sprites)
+    const float inv_area = 1.0f / area;
+    tri->FlatColor = v[0]->col == v[1]->col && v[0]->col == v[2]->col;
+    tri->Owns = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        const int a = (i + 1) % 3, b = (i + 2) % 3;
+        tri->X[i] = x[i];
+        tri->Y[i] = y[i];
+        tri->EdgeX[i] = x[b] - x[a];
+        tri->EdgeY[i] = y[b] - y[a];
+        if (tri->EdgeY[i] > 0.0f || (tri->EdgeY[i] == 0.0f && tri->EdgeX[i] < 0.0f))
+            tri->Owns |= 1 << i;
+        for (int c = 0; c < 4; c++)
+            tri->Col[i][c] = (float)((v[i]->col >> (8 * c)) & 0xFF) * (tri->FlatColor ? 1.0f : inv_area);
+        tri->U[i] = v[i]->uv.x * inv_area;
+        tri->V[i] = v[i]->uv.y * inv_area;
+    }
+
+    tri->Texture = tex;
+    tri->Texel = 0xFFFFFFFF;
+    const ImVec2 uv = v[0]->uv;
+    if (tex != nullptr && uv.x == v[1]->uv.x && uv.x == v[2]->uv.x && uv.y == v[1]->uv.y && uv.y == v[2]->uv.y)
+    {
+        const int tx = ImMin(tex->Width - 1, ImMax(0, (int)(uv.x * tex->Width)));
+        const int ty = ImMin(tex->Height - 1, ImMax(0, (int)(uv.y * tex->Height)));
+        memcpy(&tri->Texel, tex->Pixels + ((size_t)ty * tex->Width + tx) * 4, sizeof(ImU32));
+        tri->Texture = nullptr;
+    }
+
+    // A flat color on a single texel is the same source for every pixel: transparent draws nothing, opaque replaces
+    // the destination (src * 1 + dst * 0 is src exactly)
+    tri->Opaque = false;
+    tri->Pixel = 0;
+    if (tri->FlatColor && tri->Texture == nullptr)
+    {
+        float texel[4];
+        for (int c = 0; c < 4; c++)
+            texel[c] = (float)((tri->Texel >> (8 * c)) & 0xFF);
+        const float src_a = tri->Col[0][3] * texel[3] * (1.0f / (255.0f * 255.0f));
+        if (src_a == 0.0f)
+            return false;
+        if (src_a == 1.0f)
+        {
+            tri->Opaque = true;
+            tri->Pixel = (ImU32)255 << 24;
+            for (int c = 0; c < 3; c++)
+                tri->Pixel |= (ImU32)(ImMin(tri->Col[0][c] * texel[c] * (1.0f / 255.0f), 255.0f) + 0.5f) << (8 * c);
+        }
+    }
+    return true;
+}
+
+void ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, const ImGui_ImplSoft_Target* target)
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoft_Init()?");
+    const int width = ImMin(target->Width, (int)draw_data->DisplaySize.x);
+    const int height = ImMin(target->Height, (int)draw_data->DisplaySize.y);
+    if (width <= 0 || height <= 0)
+        return;
+
+    // 1. Set up every triangle that covers a pixel, in submission order
+    bd->Triangles.resize(0);
+    const ImVec2 clip_off = draw_data->DisplayPos;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                // There is no render state to reset
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into pixel space, truncated like D3D11 does
+            const ImVec2 clip_min(pcmd->ClipRect.x - clip_off.x, pcmd->ClipRect.y - clip_off.y);
+            const ImVec2 clip_max(pcmd->ClipRect.z - clip_off.x, pcmd->ClipRect.w - clip_off.y);
+            if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                continue;
+            const int scissor[4] = {
+                ImMax(0, (int)(long)clip_min.x), ImMax(0, (int)(long)clip_min.y),
+                ImMin(width, (int)(long)clip_max.x), ImMin(height, (int)(long)clip_max.y),
+            };
+            if (scissor[0] >= scissor[2] || scissor[1] >= scissor[3])
+                continue;
+
+            const ImGui_ImplSoft_Texture* texture = (const ImGui_ImplSoft_Texture*)pcmd->GetTexID();
+            const ImDrawVert* vtx = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount; i += 3)
+            {
+                if (bd->Triangles.Size == bd->Triangles.Capacity)
+                    bd->Triangles.reserve(bd->Triangles._grow_capacity(bd->Triangles.Size + 1));
+                ImGui_ImplSoft_Triangle* tri = bd->Triangles.Data + bd->Triangles.Size;
+                if (ImGui_ImplSoft_SetupTriangle(&vtx[idx[i]], &vtx[idx[i + 1]], &vtx[idx[i + 2]], clip_off, scissor, texture, tri))
+                    bd->Triangles.Size++;
+            }
+        }
+    }
+
+    // 2. Bin them: count per tile, then fill each tile's range in order
+    const int tiles_x = (width + IMGUI_IMPL_SOFT_TILE_SIZE - 1) / IMGUI_IMPL_SOFT_TILE_SIZE;
+    const int tiles_y = (height + IMGUI_IMPL_SOFT_TILE_SIZE - 1) / IMGUI_IMPL_SOFT_TILE_SIZE;
+    const int tile_count = tiles_x * tiles_y;
+    bd->BinStart.resize(tile_count + 1);
+    memset(bd->BinStart.Data, 0, (size_t)bd->BinStart.size_in_bytes());
+    for (const ImGui_ImplSoft_Triangle& tri : bd->Triangles)
+        for (int ty = tri.MinY / IMGUI_IMPL_SOFT_TILE_SIZE; ty <= tri.MaxY / IMGUI_IMPL_SOFT_TILE_SIZE; ty++)
+            for (int tx = tri.MinX / IMGUI_IMPL_SOFT_TILE_SIZE; tx <= tri.MaxX / IMGUI_IMPL_SOFT_TILE_SIZE; tx++)
+                bd->BinStart[ty * tiles_x + tx + 1]++;
+    for (int tile = 0; tile < tile_count; tile++)
+        bd->BinStart[tile + 1] += bd->BinStart[tile];
+    bd->BinTriangles.resize(bd->BinStart[tile_count]);
+    for (int tri_i = 0; tri_i < bd->Triangles.Size; tri_i++)
+    {
+        const ImGui_ImplSoft_Triangle& tri = bd->Triangles[tri_i];
+        for (int ty = tri.MinY / IMGUI_IMPL_SOFT_TILE_SIZE; ty <= tri.MaxY / IMGUI_IMPL_SOFT_TILE_SIZE; ty++)
+            for (int tx = tri.MinX / IMGUI_IMPL_SOFT_TILE_SIZE; tx <= tri.MaxX / IMGUI_IMPL_SOFT_TILE_SIZE; tx++)
+                bd->BinTriangles[bd->BinStart[ty * tiles_x + tx]++] = tri_i;
+    }
+    for (int tile = tile_count; tile > 0; tile--)   // The fill advanced every start to the next tile's, shift them back
+        bd->BinStart[tile] = bd->BinStart[tile - 1];
+    bd->BinStart[0] = 0;
+
+    // 3. Draw the tiles
+    ImGui_ImplSoft_Job job;
+    job.Data = bd;
+    job.Target = target;
+    job.Width = width;
+    job.Height = height;
+    job.TilesX = tiles_x;
+    if (bd->ParallelFor != nullptr && tile_count > 1)
+        bd->ParallelFor(tile_count, ImGui_ImplSoft_DrawTile, &job);
+    else
+        for (int tile = 0; tile < tile_count; tile++)
+            ImGui_ImplSoft_DrawTile(tile, &job);
+}
+
+void ImGui_ImplSoft_SetParallelFor(ImGui_ImplSoft_ParallelForFunc parallel_for)
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoft_Init()?");
+    bd->ParallelFor = parallel_for;
+}
+
+bool ImGui_ImplSoft_CreateDeviceObjects()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    if (!bd)
+        return false;
+    if (bd->FontTextureValid)
+        ImGui_ImplSoft_InvalidateDeviceObjects();
+
+    // The atlas keeps the pixels, the texture only points at them
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    bd->FontTexture.Pixels = pixels;
+    bd->FontTexture.Width = width;
+    bd->FontTexture.Height = height;
+    bd->FontTextureValid = true;
+    io.Fonts->SetTexID((ImTextureID)&bd->FontTexture);
+    return true;
+}
+
+void ImGui_ImplSoft_InvalidateDeviceObjects()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    if (!bd || !bd->FontTextureValid)
+        return;
+    bd->FontTextureValid = false;
+    ImGui::GetIO().Fonts->SetTexID(0);
+}
+
+bool    ImGui_ImplSoft_Init()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    ImGui_ImplSoft_Data* bd = IM_NEW(ImGui_ImplSoft_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_soft";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    return true;
+}
+
+void ImGui_ImplSoft_Shutdown()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui_ImplSoft_InvalidateDeviceObjects();
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    IM_DELETE(bd);
+}
+
+void ImGui_ImplSoft_NewFrame()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoft_Init()?");
+
+    if (!bd->FontTextureValid)
+        ImGui_ImplSoft_CreateDeviceObjects();
+}
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,58 @@
+// dear imgui: Renderer Backend for a CPU rasterizer drawing into an RGBA8 buffer in memory
+// Platform-neutral, no GPU or device: headless golden-image tests and benchmarks, or a fallback presenter.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoft_Texture*' as ImTextureID. A null ImTextureID draws untextured.
+//  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+// Missing features:
+//  [ ] Renderer: User callbacks run in order, but before any triangle is drawn (the whole frame is binned first).
+
+// Output matches the pipeline state of imgui_impl_dx11 except for the sampler: scissor rects truncated to whole pixels,
+// pixel-centre coverage with a top-left style tie rule, nearest texel sampling, SrcAlpha/InvSrcAlpha blending for color
+// and One/InvSrcAlpha for alpha. The result is the same for any thread count and with or without SSE2.
+
+// How it works:
+// - Every triangle is set up once (orientation, edges, pixel bounds clipped to its scissor rect) and binned into 64x64 tiles.
+// - Tiles are independent: each one is cleared and draws the triangles of its bin in submission order, so they can be
+//   spread over threads (ImGui_ImplSoft_SetParallelFor).
+// - Inside a tile, rows are walked 4 pixels at a time: edge functions, interpolation and blending in SSE2.
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+
+// RGBA32 texture in memory, straight alpha (e.g. from ImFontAtlas::GetTexDataAsRGBA32). Not copied, has to outlive its use.
+struct ImGui_ImplSoft_Texture
+{
+    const unsigned char*    Pixels;
+    int                     Width;
+    int                     Height;
+};
+
+// Where a frame is drawn: RGBA8 pixels with R in the low byte (same layout as IM_COL32), straight alpha
+struct ImGui_ImplSoft_Target
+{
+    ImU32*                  Pixels;
+    int                     Width;          // Drawing is clipped to both this and draw_data->DisplaySize
+    int                     Height;
+    int                     Pitch;          // Pixels from one row to the next
+    bool                    Clear;          // Clear to transparent black first (done per tile, in the same pass)
+};
+
+// Calls fn(0 .. count-1, user_data) in any order and on any thread, returns when all calls are done.
+// Same signature as ImFontAtlasParallelForFunc (imgui_internal.h), so one thread pool can serve both.
+typedef void (*ImGui_ImplSoft_ParallelForFunc)(int count, void (*fn)(int index, void* user_data), void* user_data);
+
+IMGUI_IMPL_API bool     ImGui_ImplSoft_Init();
+IMGUI_IMPL_API void     ImGui_ImplSoft_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoft_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, const ImGui_ImplSoft_Target* target);
+
+// Draw the tiles of RenderDrawData() through parallel_for, nullptr to draw them on the calling thread (default)
+IMGUI_IMPL_API void     ImGui_ImplSoft_SetParallelFor(ImGui_ImplSoft_ParallelForFunc parallel_for);
+
+// The font texture points into the atlas: call these if the atlas is rebuilt
+IMGUI_IMPL_API void     ImGui_ImplSoft_InvalidateDeviceObjects();
+IMGUI_IMPL_API bool     ImGui_ImplSoft_CreateDeviceObjects();
+
+#endif // #ifndef IMGUI_DISABLE
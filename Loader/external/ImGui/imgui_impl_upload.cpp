@@ -0,0 +1,194 @@
+// dear imgui: Upload planner for Renderer Backends with persistent vertex/index buffers
+// See imgui_impl_upload.h
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_upload.h"
+#include <string.h>     // memcpy
+
+static inline ImU64 ImUploadRotl(ImU64 x, int r)    { return (x << r) | (x >> (64 - r)); }
+static inline ImU64 ImUploadLoad64(const unsigned char* p) { ImU64 v; memcpy(&v, p, sizeof(v)); return v; }
+
+// Four independent multiply/rotate lanes over 32-byte blocks, so hashing runs close to memory speed.
+// Lists are compared by (hash, vertex count, index count): a collision would need both sizes to match as well.
+static ImU64 ImUploadHashBytes(const void* data, size_t size, ImU64 seed)
+{
+    const ImU64 K = 0x9E3779B97F4A7C15ull;
+    const unsigned char* p = (const unsigned char*)data;
+    ImU64 h0 = seed, h1 = seed ^ 0xC2B2AE3D27D4EB4Full, h2 = seed ^ 0x165667B19E3779F9ull, h3 = seed ^ 0x85EBCA77C2B2AE63ull;
+    for (; size >= 32; p += 32, size -= 32)
+    {
+        h0 = ImUploadRotl((h0 ^ ImUploadLoad64(p + 0)) * K, 31);
+        h1 = ImUploadRotl((h1 ^ ImUploadLoad64(p + 8)) * K, 31);
+        h2 = ImUploadRotl((h2 ^ ImUploadLoad64(p + 16)) * K, 31);
+        h3 = ImUploadRotl((h3 ^ ImUploadLoad64(p + 24)) * K, 31);
+    }
+    ImU64 h = h0 ^ ImUploadRotl(h1, 7) ^ ImUploadRotl(h2, 13) ^ ImUploadRotl(h3, 19);
+    for (; size >= 8; p += 8, size -= 8)
+        h = ImUploadRotl((h ^ ImUploadLoad64(p)) * K, 31);
+    if (size > 0)
+    {
+        ImU64 tail = 0;
+        memcpy(&tail, p, size);
+        h = ImUploadRotl((h ^ tail ^ ((ImU64)size << 56)) * K, 31);
+    }
+
+    // Final avalanche (MurmurHash3 fmix64)
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+ImU64 ImUploadHashDrawList(const ImDrawList* draw_list)
+{
+    ImU64 hash = ImUploadHashBytes(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert), (ImU64)draw_list->VtxBuffer.Size);
+    return ImUploadHashBytes(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx), hash);
+}
+
+// Doubles capacity until it holds twice the frame's total: the ring then always fits a full re-upload, plus room for
+// at least one more frame of changes before it has to wrap.
+static int ImUploadGrowCapacity(int capacity, int min_capacity, int total)
+{
+    if (capacity < min_capacity)
+        capacity = min_capacity;
+    const ImS64 wanted = (ImS64)total * 2;
+    ImS64 grown = capacity;
+    while (grown < wanted)
+        grown *= 2;
+    return grown > 0x7FFFFFFF ? 0x7FFFFFFF : (int)grown;
+}
+
+void ImUploadPlanner::Init(int min_vtx_capacity, int min_idx_capacity)
+{
+    MinVtxCapacity = min_vtx_capacity;
+    MinIdxCapacity = min_idx_capacity;
+    VtxCapacity = IdxCapacity = 0;
+    VtxHead = IdxHead = 0;
+    Generation = 0;
+    UploadedBytes = ReusedBytes = Discards = Recreates = 0;
+    Entries.clear();
+    NextEntries.clear();
+}
+
+void ImUploadPlanner::Invalidate()
+{
+    VtxCapacity = IdxCapacity = 0;
+    VtxHead = IdxHead = 0;
+    Generation++;
+    Entries.resize(0);
+}
+
+void ImUploadPlanner::Plan(const ImDrawData* draw_data, ImUploadPlan* out)
+{
+    const int list_count = draw_data->CmdListsCount;
+    out->Lists.resize(list_count);
+    NextEntries.resize(list_count);
+
+    // 1. Match every list with last frame's entry (usually at the same index) and keep the ones whose data is unchanged
+    //    and still in the buffer. A list is only hashed if its sizes match last frame, lists that grow or shrink every
+    //    frame (particles, an open menu being scrolled) never pay for it.
+    int vtx_total = 0, idx_total = 0;
+    int vtx_changed = 0, idx_changed = 0;
+    for (int n = 0; n < list_count; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        Entry& next = NextEntries[n];
+        next.List = draw_list;
+        next.VtxCount = draw_list->VtxBuffer.Size;
+        next.IdxCount = draw_list->IdxBuffer.Size;
+        next.Hash = 0;
+        next.HashValid = false;
+        next.VtxOffset = next.IdxOffset = 0;
+        next.Generation = Generation;
+        vtx_total += next.VtxCount;
+        idx_total += next.IdxCount;
+
+        const Entry* prev = NULL;
+        if (n < Entries.Size && Entries[n].List == draw_list)
+            prev = &Entries[n];
+        else
+            for (const Entry& entry : Entries)
+                if (entry.List == draw_list) { prev = &entry; break; }
+
+        bool reuse = false;
+        if (prev != NULL && prev->VtxCount == next.VtxCount && prev->IdxCount == next.IdxCount)
+        {
+            next.Hash = ImUploadHashDrawList(draw_list);
+            next.HashValid = true;
+            reuse = prev->HashValid && prev->Hash == next.Hash && prev->Generation == Generation;
+        }
+        if (reuse)
+        {
+            next.VtxOffset = prev->VtxOffset;
+            next.IdxOffset = prev->IdxOffset;
+        }
+        else
+        {
+            vtx_changed += next.VtxCount;
+            idx_changed += next.IdxCount;
+        }
+        out->Lists[n].Upload = !reuse;
+    }
+
+    // 2. Grow, or wrap the ring if the changed lists don't fit behind the head. Either way the old contents are gone.
+    const bool recreate = VtxCapacity == 0 || IdxCapacity == 0 || vtx_total * 2 > VtxCapacity || idx_total * 2 > IdxCapacity;
+    const bool wrap = !recreate && (VtxHead + vtx_changed > VtxCapacity || IdxHead + idx_changed > IdxCapacity);
+    if (recreate)
+    {
+        VtxCapacity = ImUploadGrowCapacity(VtxCapacity, MinVtxCapacity, vtx_total);
+        IdxCapacity = ImUploadGrowCapacity(IdxCapacity, MinIdxCapacity, idx_total);
+        Recreates++;
+    }
+    else if (wrap)
+    {
+        Discards++;
+    }
+    if (recreate || wrap)
+    {
+        Generation++;
+        VtxHead = IdxHead = 0;
+        vtx_changed = vtx_total;
+        idx_changed = idx_total;
+    }
+
+    // 3. Place the lists to upload one after another at the head
+    out->Recreate = recreate;
+    out->Discard = recreate || wrap;
+    out->VtxCapacity = VtxCapacity;
+    out->IdxCapacity = IdxCapacity;
+    out->VtxWriteBegin = VtxHead;
+    out->IdxWriteBegin = IdxHead;
+    out->UploadedLists = out->ReusedLists = 0;
+    for (int n = 0; n < list_count; n++)
+    {
+        Entry& next = NextEntries[n];
+        ImUploadPlacement& placement = out->Lists[n];
+        placement.Upload |= out->Discard;
+        if (placement.Upload)
+        {
+            next.VtxOffset = VtxHead;
+            next.IdxOffset = IdxHead;
+            VtxHead += next.VtxCount;
+            IdxHead += next.IdxCount;
+            out->UploadedLists++;
+        }
+        else
+        {
+            out->ReusedLists++;
+        }
+        next.Generation = Generation;
+        placement.VtxOffset = next.VtxOffset;
+        placement.IdxOffset = next.IdxOffset;
+    }
+    out->VtxWriteEnd = VtxHead;
+    out->IdxWriteEnd = IdxHead;
+
+    const ImU64 changed_bytes = (ImU64)vtx_changed * sizeof(ImDrawVert) + (ImU64)idx_changed * sizeof(ImDrawIdx);
+    UploadedBytes += changed_bytes;
+    ReusedBytes += (ImU64)vtx_total * sizeof(ImDrawVert) + (ImU64)idx_total * sizeof(ImDrawIdx) - changed_bytes;
+
+    Entries.swap(NextEntries);
+}
+
+#endif // #ifndef IMGUI_DISABLE
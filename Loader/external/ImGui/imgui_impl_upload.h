@@ -0,0 +1,86 @@
+// dear imgui: Upload planner for Renderer Backends with persistent vertex/index buffers
+// Platform-neutral: decides where every ImDrawList of a frame lives in the GPU buffers and which ones have to be copied.
+// The backend (see imgui_impl_dx11.cpp) only creates/maps buffers and performs the copies the plan asks for.
+
+// How it works:
+// - The vertex and index buffers are used as a ring. Lists that changed are appended after the previous frame's data
+//   (D3D11_MAP_WRITE_NO_OVERWRITE), so the data of frames still in flight is never touched.
+// - A list whose vertices and indices hash the same as last frame, and whose data is still in the current buffer,
+//   keeps its old placement and isn't copied at all (e.g. the background list carrying the crosshair and watermark).
+// - When the ring is full the buffer is discarded (D3D11_MAP_WRITE_DISCARD) and every list is uploaded again from 0.
+// - Capacities grow geometrically, to at least twice the frame's total so the ring holds a few frames of changes.
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+
+// Where one draw list lives in the buffers this frame
+struct ImUploadPlacement
+{
+    int                 VtxOffset;          // First vertex of the list in the vertex buffer (add to ImDrawCmd::VtxOffset)
+    int                 IdxOffset;          // First index of the list in the index buffer (add to ImDrawCmd::IdxOffset)
+    bool                Upload;             // Copy the list to these offsets. false: the same data is already there.
+};
+
+struct ImUploadPlan
+{
+    bool                Recreate;           // (Re)create both buffers with VtxCapacity/IdxCapacity elements before mapping
+    bool                Discard;            // Map with WRITE_DISCARD (new buffers or ring wrapped), else with WRITE_NO_OVERWRITE
+    int                 VtxCapacity;
+    int                 IdxCapacity;
+    int                 VtxWriteBegin;      // Element range written this frame, empty (Begin == End) if no list changed
+    int                 VtxWriteEnd;
+    int                 IdxWriteBegin;
+    int                 IdxWriteEnd;
+    int                 UploadedLists;
+    int                 ReusedLists;
+    ImVector<ImUploadPlacement> Lists;      // One per ImDrawData::CmdLists entry, in the same order
+
+    ImUploadPlan()      { Recreate = Discard = false; VtxCapacity = IdxCapacity = 0; VtxWriteBegin = VtxWriteEnd = IdxWriteBegin = IdxWriteEnd = 0; UploadedLists = ReusedLists = 0; }
+};
+
+struct ImUploadPlanner
+{
+    int                 MinVtxCapacity;     // Size of the first buffers
+    int                 MinIdxCapacity;
+    int                 VtxCapacity;        // Current buffer sizes, 0 until the first Plan()
+    int                 IdxCapacity;
+    int                 VtxHead;            // Next free element in the ring
+    int                 IdxHead;
+    unsigned int        Generation;         // Incremented whenever the buffer contents are lost (discard, recreate)
+
+    // Statistics
+    ImU64               UploadedBytes;
+    ImU64               ReusedBytes;
+    ImU64               Discards;
+    ImU64               Recreates;
+
+    // What each list of the last frame was, and where it was put
+    struct Entry
+    {
+        const ImDrawList*   List;
+        ImU64               Hash;
+        bool                HashValid;      // Only hashed once the list keeps its size across two frames
+        int                 VtxCount;
+        int                 IdxCount;
+        int                 VtxOffset;
+        int                 IdxOffset;
+        unsigned int        Generation;
+    };
+    ImVector<Entry>     Entries;
+    ImVector<Entry>     NextEntries;
+
+    ImUploadPlanner()   { Init(5000, 10000); }
+    IMGUI_IMPL_API void Init(int min_vtx_capacity, int min_idx_capacity);
+
+    // Fills out for this frame and assumes the backend carries it out. Call Invalidate() if it couldn't.
+    IMGUI_IMPL_API void Plan(const ImDrawData* draw_data, ImUploadPlan* out);
+
+    // The buffers were released or their contents are unknown (device reset, failed Map): recreate them on the next Plan()
+    IMGUI_IMPL_API void Invalidate();
+};
+
+// 64-bit hash of a list's vertices and indices, as compared between frames
+IMGUI_IMPL_API ImU64 ImUploadHashDrawList(const ImDrawList* draw_list);
+
+#endif // #ifndef IMGUI_DISABLE
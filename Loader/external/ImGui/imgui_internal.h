@@ -409,6 +409,18 @@ IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, cons
 IMGUI_API const char*   ImTextFindPreviousUtf8Codepoint(const char* in_text_start, const char* in_text_curr);                   // return previous UTF-8 code-point.
 IMGUI_API int           ImTextCountLines(const char* in_text, const char* in_text_end);                                         // return number of lines taken by text. trailing carriage return doesn't count as an extra line.
 
+// Printable-ASCII fast path in ImFont::CalcTextSizeA() and ImFont::RenderText() (SSE builds only).
+// Output is identical with and without it, the switch only exists so the two can be benchmarked.
+extern IMGUI_API bool   GImFontAsciiFastPath;
+
+// SSE normals and fringe offsets in ImDrawList::AddPolyline() (anti-aliased), AddConvexPolyFilled() and AddConcavePolyFilled().
+// Output is identical with and without them, the switch only exists so the two can be compared.
+extern IMGUI_API bool   GImDrawListSimdPaths;
+
+// Shape cache in ImDrawList::AddCircleFilled() and ImDrawList::AddRectFilled() with rounding. Points are identical with and without it,
+// anti-aliasing fringes move by less than 1/1000 of a pixel (the normals come from the unit outline). The switch exists for benchmarks.
+extern IMGUI_API bool   GImDrawListShapeCache;
+
 // Helpers: File System
 #ifdef IMGUI_DISABLE_FILE_FUNCTIONS
 #define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
@@ -765,6 +777,24 @@ struct ImGuiTextIndex
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: Outlines of filled circles and rounded rectangles, kept by AddCircleFilled() and AddRectFilled().
+// An outline is tessellated for a radius of 1 together with the anti-aliasing normals AddConvexPolyFilled() would compute for it,
+// keyed by what decides its points (shape, arc step, rounded corners, AA fill). Drawing one is then a scale and offset per point.
+#define IM_DRAWLIST_SHAPE_CACHE_SIZE                            32
+
+struct ImDrawListShapePoint
+{
+    ImVec2          Unit;           // Offset from the centre of its corner, for a radius of 1
+    ImVec2          Normal;         // Averaged edge normal after IM_FIXNORMAL2F(), before the AA_SIZE * 0.5f scale
+    int             Corner;         // Centre/radius the point hangs off: 0..3 = top-left, top-right, bottom-right, bottom-left. 0 for circles.
+};
+
+struct ImDrawListShape
+{
+    ImU32                           Key;        // 0 = empty slot
+    ImVector<ImDrawListShapePoint>  Points;
+};
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -786,6 +816,9 @@ struct IMGUI_API ImDrawListSharedData
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
 
+    // [Internal] Shape cache (direct mapped)
+    ImDrawListShape ShapeCache[IM_DRAWLIST_SHAPE_CACHE_SIZE];
+
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
 };
@@ -3575,6 +3608,12 @@ IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
+// Runs fn(index, user_data) once for every index in [0, count), possibly concurrently, and returns when all are done.
+// When set, ImFontAtlasBuildWithStbTruetype() hands glyph rasterization to it (after rect packing, so the output
+// bitmap doesn't depend on scheduling). NULL (default) rasterizes on the calling thread.
+typedef void        (*ImFontAtlasParallelForFunc)(int count, void (*fn)(int index, void* user_data), void* user_data);
+extern IMGUI_API ImFontAtlasParallelForFunc GImFontAtlasParallelFor;
+
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
 //-----------------------------------------------------------------------------
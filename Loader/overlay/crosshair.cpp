@@ -0,0 +1,204 @@
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "crosshair.h"
+#include <cmath>
+#include <cstring>
+
+#include <imgui_internal.h>
+
+namespace crosshair
+{
+    static constexpr double kPi = 3.14159265358979323846;
+
+    // Generators tag what they emit in the RGB bits (fringe vertices only differ in alpha), for Place():
+    //   kLineCol   lines, stroked without AddLine()'s half pixel, which Place() adds after rotating
+    //   kRoundCol  circles, never rotated: the per-frame code drew them unrotated around the center
+    //   kFillCol   everything else, rotated with the shape
+    static constexpr ImU32 kFillCol = IM_COL32_WHITE;
+    static constexpr ImU32 kLineCol = IM_COL32(255, 255, 254, 255);
+    static constexpr ImU32 kRoundCol = IM_COL32(255, 254, 255, 255);
+
+    static inline bool HasTag(ImU32 localCol, ImU32 tag)
+    {
+        return (localCol & ~IM_COL32_A_MASK) == (tag & ~IM_COL32_A_MASK);
+    }
+
+    // ImDrawList::AddLine() without the +0.5 on the end points
+    static void Line(ImDrawList* dl, const ImVec2& p1, const ImVec2& p2, float thickness)
+    {
+        dl->PathLineTo(p1);
+        dl->PathLineTo(p2);
+        dl->PathStroke(kLineCol, 0, thickness);
+    }
+
+    // ----- Shape generators (same shapes the overlay used to draw every frame, emitted around (0,0)) -----
+    static void GenerateCross(ImDrawList* dl, float r, float thickness, float)
+    {
+        Line(dl, ImVec2(-r, -r), ImVec2(r, r), thickness);
+        Line(dl, ImVec2(r, -r), ImVec2(-r, r), thickness);
+    }
+
+    static void GenerateDot(ImDrawList* dl, float r, float thickness, float)
+    {
+        IM_UNUSED(thickness);
+        dl->AddCircleFilled(ImVec2(0.0f, 0.0f), r * 0.5f, kRoundCol);
+    }
+
+    static void GeneratePlus(ImDrawList* dl, float r, float thickness, float)
+    {
+        Line(dl, ImVec2(-r, 0.0f), ImVec2(r, 0.0f), thickness);
+        Line(dl, ImVec2(0.0f, -r), ImVec2(0.0f, r), thickness);
+    }
+
+    static void GenerateTriangle(ImDrawList* dl, float r, float thickness, float)
+    {
+        ImVec2 p1(0.0f, -r);
+        ImVec2 p2(-(0.866f * r), r / 2.0f);
+        ImVec2 p3(0.866f * r, r / 2.0f);
+        dl->AddTriangle(p1, p2, p3, kFillCol, thickness);
+    }
+
+    static void GenerateCircle(ImDrawList* dl, float r, float thickness, float)
+    {
+        dl->AddCircle(ImVec2(0.0f, 0.0f), r, kRoundCol, 0, thickness);
+    }
+
+    // The ends of the vertical bar (and the top/bottom tips) sit at floor(center.y) -/+ 2r like the old
+    // (int) truncation put them, the horizontal bar at center.y
+    static void GenerateWindmill1954(ImDrawList* dl, float r, float thickness, float centerFracY)
+    {
+        float arm = 2.0f * r;
+        ImVec2 top(0.0f, -arm - centerFracY);
+        ImVec2 bot(0.0f, arm - centerFracY);
+        ImVec2 right(arm, 0.0f);
+        ImVec2 left(-arm, 0.0f);
+
+        Line(dl, top, bot, thickness);
+        Line(dl, left, right, thickness);
+        Line(dl, top, ImVec2(top.x + arm, top.y), thickness);
+        Line(dl, bot, ImVec2(bot.x - arm, bot.y), thickness);
+        Line(dl, right, ImVec2(right.x, right.y + arm), thickness);
+        Line(dl, left, ImVec2(left.x, left.y - arm), thickness);
+    }
+
+    static void GeneratePinwheel(ImDrawList* dl, float r, float thickness, float)
+    {
+        double start = kPi / 4.0;
+        for (int i = 0; i < 4; i++)
+        {
+            double ang = start + i * (kPi / 2.0);
+            ImVec2 p1(static_cast<float>(cos(ang) * (r * 0.35)), static_cast<float>(sin(ang) * (r * 0.35)));
+            ImVec2 p2(static_cast<float>(cos(ang) * r), static_cast<float>(sin(ang) * r));
+            Line(dl, p1, p2, thickness);
+        }
+        dl->AddCircleFilled(ImVec2(0.0f, 0.0f), r * 0.12f, kRoundCol);
+    }
+
+    // Indexed by Shape
+    static constexpr Generator kGenerators[] = {
+        GenerateCross,
+        GenerateDot,
+        GeneratePlus,
+        GenerateTriangle,
+        GenerateCircle,
+        GenerateWindmill1954,
+        GeneratePinwheel,
+    };
+    static_assert(IM_ARRAYSIZE(kGenerators) == IM_ARRAYSIZE(kShapeNames), "every crosshair menu entry needs a generator");
+
+    static void Tessellate(ImDrawList* dl, const Params& params)
+    {
+        const float thickness = static_cast<float>((params.thickness > 1) ? params.thickness : 1);
+        kGenerators[static_cast<int>(params.shape)](dl, static_cast<float>(params.size), thickness, params.centerFracY);
+    }
+
+    bool NeedsRebuild(const Geometry& geo, const Params& params, const ImDrawListSharedData* shared)
+    {
+        if (!geo.Built || geo.params != params) return true;
+        return geo.Flags != shared->InitialFlags
+            || geo.TexUvWhitePixel.x != shared->TexUvWhitePixel.x || geo.TexUvWhitePixel.y != shared->TexUvWhitePixel.y
+            || geo.TexUvLines != shared->TexUvLines
+            || geo.CircleSegmentMaxError != shared->CircleSegmentMaxError;
+    }
+
+    void Build(Geometry& geo, const Params& params, const ImDrawListSharedData* shared)
+    {
+        ImDrawList scratch(const_cast<ImDrawListSharedData*>(shared));
+        scratch._ResetForNewFrame();
+        if (params.size > 0 && params.thickness > 0)
+            Tessellate(&scratch, params);
+
+        const int vtxCount = scratch.VtxBuffer.Size;
+        geo.LocalPos.resize(vtxCount);
+        geo.LocalCol.resize(vtxCount);
+        geo.VtxBuffer.resize(vtxCount);
+        for (int i = 0; i < vtxCount; i++)
+        {
+            geo.LocalPos[i] = scratch.VtxBuffer[i].pos;
+            geo.LocalCol[i] = scratch.VtxBuffer[i].col;
+            geo.VtxBuffer[i] = scratch.VtxBuffer[i];
+        }
+        geo.IdxBuffer = scratch.IdxBuffer;
+
+        geo.params = params;
+        geo.Flags = shared->InitialFlags;
+        geo.TexUvWhitePixel = shared->TexUvWhitePixel;
+        geo.TexUvLines = shared->TexUvLines;
+        geo.CircleSegmentMaxError = shared->CircleSegmentMaxError;
+        geo.Built = true;
+        geo.Placed = false;
+        geo.BuildCount++;
+    }
+
+    void Place(Geometry& geo, const ImVec2& center, float angleRad, ImU32 col)
+    {
+        const bool moved = !geo.Placed || center.x != geo.Center.x || center.y != geo.Center.y || angleRad != geo.AngleRad;
+        const bool tinted = !geo.Placed || col != geo.Color;
+        if (!moved && !tinted) return;
+
+        const int vtxCount = geo.VtxBuffer.Size;
+        if (moved)
+        {
+            const float ca = cosf(angleRad);
+            const float sa = sinf(angleRad);
+            for (int i = 0; i < vtxCount; i++)
+            {
+                const ImVec2 p = geo.LocalPos[i];
+                const ImU32 tag = geo.LocalCol[i];
+                const bool rotate = angleRad != 0.0f && !HasTag(tag, kRoundCol);
+                const ImVec2 pos = rotate ? ImVec2(center.x + p.x * ca - p.y * sa, center.y + p.x * sa + p.y * ca) : center + p;
+                const float offset = HasTag(tag, kLineCol) ? 0.5f : 0.0f; // AddLine()'s, in screen space
+                geo.VtxBuffer[i].pos = ImVec2(pos.x + offset, pos.y + offset);
+            }
+        }
+        if (tinted)
+        {
+            // Fringe vertices were emitted with alpha 0, keep them transparent
+            const ImU32 colTrans = col & ~IM_COL32_A_MASK;
+            for (int i = 0; i < vtxCount; i++)
+                geo.VtxBuffer[i].col = (geo.LocalCol[i] & IM_COL32_A_MASK) ? col : colTrans;
+        }
+
+        geo.Center = center;
+        geo.AngleRad = angleRad;
+        geo.Color = col;
+        geo.Placed = true;
+    }
+
+    void Blit(ImDrawList* dl, const Geometry& geo)
+    {
+        const int vtxCount = geo.VtxBuffer.Size;
+        const int idxCount = geo.IdxBuffer.Size;
+        if (vtxCount == 0 || idxCount == 0 || (geo.Color & IM_COL32_A_MASK) == 0) return;
+
+        dl->PrimReserve(idxCount, vtxCount);
+        memcpy(dl->_VtxWritePtr, geo.VtxBuffer.Data, vtxCount * sizeof(ImDrawVert));
+
+        const ImDrawIdx base = static_cast<ImDrawIdx>(dl->_VtxCurrentIdx);
+        for (int i = 0; i < idxCount; i++)
+            dl->_IdxWritePtr[i] = static_cast<ImDrawIdx>(geo.IdxBuffer[i] + base);
+
+        dl->_VtxWritePtr += vtxCount;
+        dl->_IdxWritePtr += idxCount;
+        dl->_VtxCurrentIdx += static_cast<unsigned int>(vtxCount);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <imgui.h>
+
+struct ImDrawListSharedData;
+
+// Crosshair geometry cache: the shape is tessellated once into a vertex/index blob
+// and copied into the draw list every frame instead of being rebuilt from scratch.
+namespace crosshair
+{
+    // Index order matches config->crosshair.type and the "Type" combo in the menu
+    enum class Shape : int {
+        Cross = 0,
+        Dot,
+        Plus,
+        Triangle,
+        Circle,
+        Windmill1954,
+        Pinwheel,
+        Count
+    };
+
+    inline constexpr const char* kShapeNames[] = { "Cross", "Dot", "Plus", "Triangle", "Circle", "Windmill1954", "Pinwheel" };
+    static_assert(IM_ARRAYSIZE(kShapeNames) == static_cast<int>(Shape::Count), "every crosshair shape needs a menu name");
+
+    // Out-of-range config values fall back to the first shape
+    constexpr Shape ShapeFromIndex(int index) {
+        return (index >= 0 && index < static_cast<int>(Shape::Count)) ? static_cast<Shape>(index) : Shape::Cross;
+    }
+
+    // Emits one shape of the given size around (0,0), see Params::centerFracY
+    using Generator = void (*)(ImDrawList* dl, float size, float thickness, float centerFracY);
+
+    // Everything the tessellation depends on. Position, rotation and color are
+    // applied to the cached vertices afterwards and never force a rebuild.
+    struct Params {
+        Shape shape = Shape::Dot;
+        int size = 0;
+        int thickness = 0;
+        // Windmill1954 only, 0 for the other shapes: center.y - floor(center.y). Its vertical bar used to be
+        // truncated to whole pixels in screen space, this keeps it where that put it on odd display heights.
+        float centerFracY = 0.0f;
+
+        bool operator==(const Params& o) const { return size == o.size && thickness == o.thickness && shape == o.shape && centerFracY == o.centerFracY; }
+        bool operator!=(const Params& o) const { return !(*this == o); }
+    };
+
+    struct Geometry {
+        // Tessellated around (0,0), unrotated, near-white (fringe vertices keep alpha 0). The RGB bits tag lines,
+        // which Place() offsets by AddLine()'s half pixel after rotating, and circles, which it doesn't rotate:
+        // the same pixels the per-frame drawing with rotated end points gave.
+        Params params;
+        ImVector<ImVec2> LocalPos;
+        ImVector<ImU32> LocalCol;
+        ImVector<ImDrawIdx> IdxBuffer;
+
+        // Draw list setup the blob was built against (atlas UVs, AA flags, tessellation error)
+        ImDrawListFlags Flags = 0;
+        ImVec2 TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+        const ImVec4* TexUvLines = nullptr;
+        float CircleSegmentMaxError = 0.0f;
+        bool Built = false;
+
+        // Blob ready to be copied: LocalPos moved to Center, rotated by AngleRad, tinted with Color
+        ImVector<ImDrawVert> VtxBuffer;
+        ImVec2 Center = ImVec2(0.0f, 0.0f);
+        float AngleRad = 0.0f;
+        ImU32 Color = 0;
+        bool Placed = false;
+
+        // Incremented on every Build(), handy to check that a static crosshair isn't re-tessellated
+        unsigned int BuildCount = 0;
+    };
+
+    // True if geo was built for different params or against a different draw list setup.
+    bool NeedsRebuild(const Geometry& geo, const Params& params, const ImDrawListSharedData* shared);
+
+    // Tessellates params into geo with a scratch ImDrawList. Only needs the shared data
+    // (no ImGui context or renderer), so it can be driven headless.
+    void Build(Geometry& geo, const Params& params, const ImDrawListSharedData* shared);
+
+    // Moves, rotates and tints the cached vertices. Does nothing if none of them changed.
+    void Place(Geometry& geo, const ImVec2& center, float angleRad, ImU32 col);
+
+    // Appends the placed blob to dl with a single PrimReserve.
+    void Blit(ImDrawList* dl, const Geometry& geo);
+}
@@ -0,0 +1,281 @@
+#include "drawmerge.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+namespace drawmerge
+{
+    // Same rule as the profiler's draw call count: everything the backend issues a DrawIndexed for
+    static bool IsDraw(const ImDrawCmd& cmd)
+    {
+        return cmd.UserCallback == nullptr && cmd.ElemCount > 0;
+    }
+
+    static bool HasCallbacks(const ImDrawList* list)
+    {
+        for (const ImDrawCmd& cmd : list->CmdBuffer)
+            if (cmd.UserCallback != nullptr)
+                return true;
+        return false;
+    }
+
+    static bool SameClip(const ImDrawCmd& a, const ImDrawCmd& b)
+    {
+        return memcmp(&a.ClipRect, &b.ClipRect, sizeof(ImVec4)) == 0;
+    }
+
+    static unsigned int MaxIndex(const ImDrawIdx* idx, unsigned int count)
+    {
+        unsigned int hi = 0;
+        for (unsigned int i = 0; i < count; i++)
+            hi = std::max(hi, static_cast<unsigned int>(idx[i]));
+        return hi;
+    }
+
+    // The backend truncates the clip rect (relative to DisplayPos) to whole pixels and the rasterizer only
+    // touches pixels whose centre is inside a triangle, so geometry within the truncated rect is never cut
+    static bool InsideScissor(const ImVec4& b, const ImVec4& clip, const ImVec2& off)
+    {
+        return b.x - off.x >= static_cast<float>(static_cast<long>(clip.x - off.x))
+            && b.y - off.y >= static_cast<float>(static_cast<long>(clip.y - off.y))
+            && b.z - off.x <= static_cast<float>(static_cast<long>(clip.z - off.x))
+            && b.w - off.y <= static_cast<float>(static_cast<long>(clip.w - off.y));
+    }
+
+    static void Measure(const ImDrawList* list, const ImDrawCmd& cmd, const ImVec2& off, CmdState& state)
+    {
+        const ImDrawIdx* idx = list->IdxBuffer.Data + cmd.IdxOffset;
+        unsigned int lo = UINT32_MAX, hi = 0;
+        for (unsigned int i = 0; i < cmd.ElemCount; i++)
+        {
+            lo = std::min(lo, static_cast<unsigned int>(idx[i]));
+            hi = std::max(hi, static_cast<unsigned int>(idx[i]));
+        }
+
+        // Commands index a contiguous run of vertices, so the range between the extremes is the command's own
+        ImVec4 b(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        const ImDrawVert* vtx = list->VtxBuffer.Data + cmd.VtxOffset;
+        for (unsigned int i = lo; i <= hi && lo <= hi; i++)
+        {
+            b.x = std::min(b.x, vtx[i].pos.x);
+            b.y = std::min(b.y, vtx[i].pos.y);
+            b.z = std::max(b.z, vtx[i].pos.x);
+            b.w = std::max(b.w, vtx[i].pos.y);
+        }
+        state.bounds = b;
+        state.unclipped = InsideScissor(b, cmd.ClipRect, off);
+        state.measured = true;
+    }
+
+    // Whether cmd (from src) can be drawn by the same DrawIndexed as prev (last command written to dst).
+    // The caller has already made their index ranges contiguous and their VtxOffset equal.
+    static bool CanFold(const ImDrawList* dst, const ImDrawCmd& prev, CmdState& prevState, const ImDrawList* src, const ImDrawCmd& cmd, CmdState& cmdState, const ImVec2& off)
+    {
+        if (!IsDraw(prev) || !IsDraw(cmd) || prev.TextureId != cmd.TextureId)
+            return false;
+        if (SameClip(prev, cmd))
+            return true;
+        if (!prevState.measured)
+            Measure(dst, prev, off, prevState);
+        if (!prevState.unclipped)
+            return false;
+        if (!cmdState.measured)
+            Measure(src, cmd, off, cmdState);
+        return cmdState.unclipped;
+    }
+
+    static void Fold(ImDrawCmd& prev, CmdState& prevState, const ImDrawCmd& cmd, const CmdState& cmdState)
+    {
+        if (!SameClip(prev, cmd))
+        {
+            // Both are unclipped, the union clips neither of them
+            prev.ClipRect = ImVec4(std::min(prev.ClipRect.x, cmd.ClipRect.x), std::min(prev.ClipRect.y, cmd.ClipRect.y),
+                std::max(prev.ClipRect.z, cmd.ClipRect.z), std::max(prev.ClipRect.w, cmd.ClipRect.w));
+        }
+        if (prevState.measured && cmdState.measured)
+        {
+            prevState.bounds = ImVec4(std::min(prevState.bounds.x, cmdState.bounds.x), std::min(prevState.bounds.y, cmdState.bounds.y),
+                std::max(prevState.bounds.z, cmdState.bounds.z), std::max(prevState.bounds.w, cmdState.bounds.w));
+            prevState.unclipped = prevState.unclipped && cmdState.unclipped;
+        }
+        else
+        {
+            prevState.measured = false;
+        }
+        prev.ElemCount += cmd.ElemCount;
+    }
+
+    // Folds the commands of one list into each other without touching its vertices or indices
+    void Merger::FoldInPlace(ImDrawList* list, const ImVec2& clipOff)
+    {
+        ImVector<ImDrawCmd>& cmds = list->CmdBuffer;
+        states.clear();
+        int written = 0;
+        for (int i = 0; i < cmds.Size; i++)
+        {
+            const ImDrawCmd cmd = cmds[i];
+            if (cmd.UserCallback == nullptr && cmd.ElemCount == 0)
+                continue;
+
+            CmdState state;
+            if (written > 0)
+            {
+                ImDrawCmd& prev = cmds[written - 1];
+                if (prev.VtxOffset == cmd.VtxOffset && prev.IdxOffset + prev.ElemCount == cmd.IdxOffset
+                    && CanFold(list, prev, states.back(), list, cmd, state, clipOff))
+                {
+                    Fold(prev, states.back(), cmd, state);
+                    continue;
+                }
+            }
+            cmds[written++] = cmd;
+            states.push_back(state);
+        }
+        cmds.resize(written);
+    }
+
+    // Appends src's vertices, indices and commands to out. Indices are rebased onto the previous command's
+    // VtxOffset whenever they stay in ImDrawIdx range, which is what lets commands fold across lists.
+    void Merger::Append(ImDrawList* out, const ImDrawList* src, const ImVec2& clipOff)
+    {
+        const unsigned int vtxBase = static_cast<unsigned int>(out->VtxBuffer.Size);
+        out->VtxBuffer.resize(out->VtxBuffer.Size + src->VtxBuffer.Size);
+        memcpy(out->VtxBuffer.Data + vtxBase, src->VtxBuffer.Data, src->VtxBuffer.size_in_bytes());
+
+        for (const ImDrawCmd& cmd : src->CmdBuffer)
+        {
+            if (cmd.UserCallback == nullptr && cmd.ElemCount == 0)
+                continue;
+
+            ImDrawCmd copy = cmd;
+            copy.VtxOffset = vtxBase + cmd.VtxOffset;
+            copy.IdxOffset = static_cast<unsigned int>(out->IdxBuffer.Size);
+            const ImDrawIdx* idx = src->IdxBuffer.Data + cmd.IdxOffset;
+            unsigned int delta = 0;
+            if (!out->CmdBuffer.empty())
+            {
+                const unsigned int d = copy.VtxOffset - out->CmdBuffer.back().VtxOffset;
+                if (d > 0 && (sizeof(ImDrawIdx) > 2 || d + MaxIndex(idx, cmd.ElemCount) <= 0xFFFF))
+                {
+                    delta = d;
+                    copy.VtxOffset -= d;
+                }
+            }
+
+            out->IdxBuffer.resize(out->IdxBuffer.Size + static_cast<int>(cmd.ElemCount));
+            ImDrawIdx* dst = out->IdxBuffer.Data + copy.IdxOffset;
+            if (delta == 0)
+                memcpy(dst, idx, cmd.ElemCount * sizeof(ImDrawIdx));
+            else
+                for (unsigned int i = 0; i < cmd.ElemCount; i++)
+                    dst[i] = static_cast<ImDrawIdx>(idx[i] + delta);
+
+            CmdState state;
+            if (!out->CmdBuffer.empty())
+            {
+                ImDrawCmd& prev = out->CmdBuffer.back();
+                if (prev.VtxOffset == copy.VtxOffset && CanFold(out, prev, states.back(), out, copy, state, clipOff))
+                {
+                    Fold(prev, states.back(), copy, state);
+                    continue;
+                }
+            }
+            out->CmdBuffer.push_back(copy);
+            states.push_back(state);
+        }
+    }
+
+    // Whether next's first command would fold into tail's last one if next were appended to tail
+    bool Merger::BoundaryFolds(const ImDrawList* tail, const ImDrawList* next, const ImVec2& clipOff)
+    {
+        if (tail->CmdBuffer.empty() || states.empty())
+            return false;
+        const ImDrawCmd* first = nullptr;
+        for (const ImDrawCmd& cmd : next->CmdBuffer)
+            if (cmd.UserCallback != nullptr || cmd.ElemCount > 0) { first = &cmd; break; }
+        if (first == nullptr)
+            return false;
+
+        const ImDrawCmd& last = tail->CmdBuffer.back();
+        const unsigned int d = static_cast<unsigned int>(tail->VtxBuffer.Size) + first->VtxOffset - last.VtxOffset;
+        if (sizeof(ImDrawIdx) == 2 && d + MaxIndex(next->IdxBuffer.Data + first->IdxOffset, first->ElemCount) > 0xFFFF)
+            return false;
+
+        CmdState state;
+        return CanFold(tail, last, states.back(), next, *first, state, clipOff);
+    }
+
+    Stats Merger::Run(ImDrawData* drawData)
+    {
+        Stats stats;
+        stats.listsIn = drawData->CmdListsCount;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+            for (const ImDrawCmd& cmd : drawData->CmdLists[n]->CmdBuffer)
+                stats.drawCallsIn += IsDraw(cmd) ? 1 : 0;
+
+        // pending: last list, folded in place but not emitted yet. group: pool list pending was copied into
+        // because the next list folds onto it; further lists are appended while their boundary folds too.
+        const ImVec2 clipOff = drawData->DisplayPos;
+        ImDrawList* pending = nullptr;
+        ImDrawList* group = nullptr;
+        size_t poolUsed = 0;
+        outLists.clear();
+        auto flush = [&] {
+            if (group != nullptr)
+                outLists.push_back(group);
+            else if (pending != nullptr)
+                outLists.push_back(pending);
+            group = pending = nullptr;
+        };
+
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            ImDrawList* list = drawData->CmdLists[n];
+            if (HasCallbacks(list))
+            {
+                // Callbacks get the list pointer and may look at its buffers, keep it as ImGui built it
+                flush();
+                outLists.push_back(list);
+                continue;
+            }
+
+            ImDrawList* tail = group != nullptr ? group : pending;
+            if (tail != nullptr && BoundaryFolds(tail, list, clipOff))
+            {
+                if (group == nullptr)
+                {
+                    if (poolUsed == pool.size())
+                        pool.push_back(std::make_unique<ImDrawList>(list->_Data));
+                    group = pool[poolUsed++].get();
+                    group->CmdBuffer.resize(0);
+                    group->IdxBuffer.resize(0);
+                    group->VtxBuffer.resize(0);
+                    states.clear();
+                    Append(group, pending, clipOff);
+                    pending = nullptr;
+                }
+                Append(group, list, clipOff);
+                continue;
+            }
+
+            flush();
+            FoldInPlace(list, clipOff);
+            pending = list;
+        }
+        flush();
+
+        drawData->CmdLists.resize(static_cast<int>(outLists.size()));
+        if (!outLists.empty())
+            memcpy(drawData->CmdLists.Data, outLists.data(), outLists.size() * sizeof(ImDrawList*));
+        drawData->CmdListsCount = drawData->CmdLists.Size;
+
+        stats.listsOut = drawData->CmdListsCount;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+            for (const ImDrawCmd& cmd : drawData->CmdLists[n]->CmdBuffer)
+                stats.drawCallsOut += IsDraw(cmd) ? 1 : 0;
+
+        last = stats;
+        totalSaved += static_cast<uint64_t>(stats.Saved());
+        return stats;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <imgui.h>
+
+// Optional pass between ImGui::Render() and the renderer backend that folds neighbouring draw commands into
+// one indexed draw, also across draw list boundaries (background list -> menu window -> its child windows).
+// Two commands fold when they use the same texture and either have the same clip rect, or neither one's
+// geometry reaches past its own (pixel-snapped) scissor rect: the merged command then clips to the union and
+// every pixel comes out the same. Platform neutral.
+namespace drawmerge
+{
+    struct Stats {
+        int listsIn = 0;
+        int listsOut = 0;
+        int drawCallsIn = 0;        // commands the backend would issue without the pass
+        int drawCallsOut = 0;
+
+        int Saved() const { return drawCallsIn - drawCallsOut; }
+    };
+
+    // What is known about the geometry of a command written by the pass
+    struct CmdState {
+        ImVec4 bounds;              // bounding box of the vertices the command's indices reach
+        bool unclipped = false;     // bounds inside the command's scissor rect
+        bool measured = false;      // bounds/unclipped are only computed when a fold depends on them
+    };
+
+    struct Merger {
+        // Rewrites drawData in place. Lists whose boundary commands fold are concatenated into lists owned by
+        // the merger (valid until the next Run()), the others keep their pointer and only get their own
+        // commands folded. Lists with user callbacks are left alone.
+        Stats Run(ImDrawData* drawData);
+
+        Stats last;
+        uint64_t totalSaved = 0;
+
+    private:
+        void FoldInPlace(ImDrawList* list, const ImVec2& clipOff);
+        void Append(ImDrawList* out, const ImDrawList* src, const ImVec2& clipOff);
+        bool BoundaryFolds(const ImDrawList* tail, const ImDrawList* next, const ImVec2& clipOff);
+
+        std::vector<std::unique_ptr<ImDrawList>> pool; // concatenated lists, reused frame to frame
+        std::vector<ImDrawList*> outLists;
+        std::vector<CmdState> states;                  // per command of the list being written
+    };
+}
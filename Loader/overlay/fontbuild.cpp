@@ -0,0 +1,52 @@
+#include "fontbuild.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace fontbuild
+{
+    static std::atomic<unsigned int> g_threads{ 1 };
+
+    // Workers pull task indices from a shared counter until they run out, the calling thread works too
+    static void ParallelFor(int count, void (*fn)(int index, void* userData), void* userData)
+    {
+        std::atomic<int> next{ 0 };
+        auto work = [&] {
+            for (int i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed))
+                fn(i, userData);
+        };
+
+        const unsigned int threads = g_threads.load(std::memory_order_relaxed);
+        const unsigned int workers = (count > 1 && threads > 1) ? std::min(threads, static_cast<unsigned int>(count)) - 1 : 0;
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (unsigned int i = 0; i < workers; i++)
+            pool.emplace_back(work);
+        work();
+        for (std::thread& t : pool)
+            t.join();
+    }
+
+    void EnableParallelRasterization(unsigned int threads)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        g_threads.store(threads, std::memory_order_relaxed);
+        GImFontAtlasParallelFor = threads > 1 ? ParallelFor : nullptr;
+    }
+
+    void DisableParallelRasterization()
+    {
+        g_threads.store(1, std::memory_order_relaxed);
+        GImFontAtlasParallelFor = nullptr;
+    }
+
+    unsigned int RasterizationThreads()
+    {
+        return GImFontAtlasParallelFor ? g_threads.load(std::memory_order_relaxed) : 1;
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// Spreads the glyph rasterization of ImFontAtlas::Build() across threads through the GImFontAtlasParallelFor
+// hook in imgui_draw.cpp. Rects are packed before the hook runs, so the atlas is byte-identical for any thread count.
+namespace fontbuild
+{
+    // threads: workers including the calling thread, 0 = std::thread::hardware_concurrency()
+    void EnableParallelRasterization(unsigned int threads = 0);
+
+    // Back to rasterizing on the thread that calls Build()
+    void DisableParallelRasterization();
+
+    // Threads the next Build() will use (1 when disabled)
+    unsigned int RasterizationThreads();
+}
@@ -1,5 +1,10 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "overlay.h"
+#include "pacing.h"
+#include "profiler.h"
+#include "fontbuild.h"
+#include "drawmerge.h"
+#include "menu/configsnapshot.h"
 #include <imgui.h>
 #include <imgui_impl_dx11.h>
 #include <imgui_impl_win32.h>
@@ -87,6 +92,8 @@ int load()
     ImGui_ImplWin32_Init(hwnd);
     ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
 
+    // Atlas glyphs are rasterized on all cores (same bitmap as a serial build)
+    fontbuild::EnableParallelRasterization();
     menu::InitStyle();
 
     ::ShowWindow(hwnd, SW_SHOWDEFAULT);
@@ -94,22 +101,31 @@ int load()
     
     static bool menuKeyWasPressed = false;
     bool done = false;
+    pacing::FramePacer framePacer;
+    drawmerge::Merger drawMerger;
 
     while (!done)
     {
-        MSG msg;
-        while (::PeekMessage(&msg, nullptr, 0U, 0U, PM_REMOVE))
+        profiler::BeginFrame();
+
         {
-            ::TranslateMessage(&msg);
-            ::DispatchMessage(&msg);
-            if (msg.message == WM_QUIT)
-                done = true;
+            PROFILE_SCOPE(profiler::Stage::MessagePump);
+            MSG msg;
+            while (::PeekMessage(&msg, nullptr, 0U, 0U, PM_REMOVE))
+            {
+                ::TranslateMessage(&msg);
+                ::DispatchMessage(&msg);
+                if (msg.message == WM_QUIT)
+                    done = true;
+            }
         }
         if (done) break;
 
         // Handle window resize
+        bool resized = false;
         if (g_ResizeWidth != 0 && g_ResizeHeight != 0)
         {
+            resized = true;
             CleanupRenderTarget();
             g_pSwapChain->ResizeBuffers(0, g_ResizeWidth, g_ResizeHeight, DXGI_FORMAT_UNKNOWN, 0);
             g_ResizeWidth = g_ResizeHeight = 0;
@@ -117,15 +133,26 @@ int load()
         }
 
         // Start ImGui frame
-        ImGui_ImplDX11_NewFrame();
-        ImGui_ImplWin32_NewFrame();
-        ImGui::NewFrame();
+        {
+            PROFILE_SCOPE(profiler::Stage::NewFrame);
+            ImGui_ImplDX11_NewFrame();
+            ImGui_ImplWin32_NewFrame();
+            ImGui::NewFrame();
+        }
+
+        menu::PollConfigIO();
+        g_textCache->NewFrame();
 
         // Draw overlay GUI inside ImGui frame
-        if (globals->menuOpen) {
-            menu::Draw();
+        if (globals->menuOpen || globals->showProfiler) {
+            PROFILE_SCOPE(profiler::Stage::MenuDraw);
+            if (globals->menuOpen) menu::Draw();
+            if (globals->showProfiler) profiler::DrawPanel(&globals->showProfiler);
+        }
+        {
+            PROFILE_SCOPE(profiler::Stage::OverlayDraw);
+            overlay::draw_gui();
         }
-        overlay::draw_gui();
 
         // Menu key handling
         if (!g_capturingMenuKey.load()) {
@@ -139,18 +166,48 @@ int load()
             }
         }
 
-        // Render
-        ImGui::Render();
-        g_pd3dDeviceContext->OMSetRenderTargets(1, &g_mainRenderTargetView, nullptr);
-        const float clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-        g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, clear_color);
-        ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
-        g_pSwapChain->Present(1, 0);
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // Render (skipped entirely when the frame is identical to what is already on screen)
+        {
+            PROFILE_SCOPE(profiler::Stage::Render);
+            ImGui::Render();
+        }
+        const bool animating = globals->menuOpen || globals->showProfiler || overlay::RainbowCrosshair || (overlay::IsRotating && config->crosshair.enabled);
+        const bool present = framePacer.ShouldPresent(ImGui::GetDrawData(), animating, resized);
+        if (present) {
+            {
+                PROFILE_SCOPE(profiler::Stage::RenderDrawData);
+                g_pd3dDeviceContext->OMSetRenderTargets(1, &g_mainRenderTargetView, nullptr);
+                const float clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, clear_color);
+                if (globals->mergeDrawCalls)
+                    profiler::AddDrawCallsSaved(drawMerger.Run(ImGui::GetDrawData()).Saved());
+                ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+            }
+            PROFILE_SCOPE(profiler::Stage::Present);
+            g_pSwapChain->Present(1, 0);
+        }
+        profiler::EndFrame(ImGui::GetDrawData(), present);
+
+        // This frame's config edits become visible to other threads as one batch
+        configSnapshots->Publish(*config, g_configGeneration);
+
+        // Idle: block until input arrives or the menu key changes state, without building frames in between
+        // (one every idleFrameMs for config I/O and the file watch)
+        if (framePacer.IsIdle()) {
+            framePacer.WaitIdle(
+                [](unsigned int ms) { return ::MsgWaitForMultipleObjectsEx(0, nullptr, ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE) == WAIT_OBJECT_0; },
+                [] {
+                    if (g_capturingMenuKey.load() || config->menu.menuKey == 0) return false;
+                    const bool keyDown = (GetAsyncKeyState(config->menu.menuKey) & 0x8000) != 0;
+                    return keyDown != menuKeyWasPressed;
+                });
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
     }
 
     StopTopmostMonitor();
+    menu::ShutdownConfigIO();
 
     ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
@@ -0,0 +1,123 @@
+#include "configcatalog.h"
+#include "configfile.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace configcatalog
+{
+    bool Entry::operator==(const Entry& other) const
+    {
+        return name == other.name && size == other.size && modified == other.modified && version == other.version;
+    }
+
+    static Entry MakeEntry(const std::filesystem::directory_entry& ent)
+    {
+        std::error_code ec;
+        Entry e;
+        e.name = ent.path().stem().string();
+        e.size = ent.file_size(ec);
+        e.modified = ent.last_write_time(ec);
+        e.version = configfile::ProbeVersion(ent.path().string());
+        return e;
+    }
+
+    Entry Stat(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        const std::filesystem::directory_entry ent(path, ec);
+        if (ec || !ent.is_regular_file(ec)) return Entry();
+        return MakeEntry(ent);
+    }
+
+    Catalog::Catalog(std::string dir)
+        : directory(std::move(dir))
+    {
+    }
+
+    Catalog::~Catalog()
+    {
+        CloseWatch();
+    }
+
+    const std::vector<Entry>& Catalog::Entries()
+    {
+        Poll(std::chrono::steady_clock::now());
+        return entries;
+    }
+
+    bool Catalog::Poll(std::chrono::steady_clock::time_point now)
+    {
+        bool changed = dirty;
+        if (!changed) {
+            if (watch)
+                changed = WatchSignaled();
+            else
+                changed = now - lastScan >= pollInterval;
+        }
+        if (!changed) return false;
+        Rescan(now);
+        return true;
+    }
+
+    int Catalog::Find(const std::string& name) const
+    {
+        auto it = std::lower_bound(entries.begin(), entries.end(), name, [](const Entry& e, const std::string& n) { return e.name < n; });
+        return (it != entries.end() && it->name == name) ? static_cast<int>(it - entries.begin()) : -1;
+    }
+
+    void Catalog::Rescan(std::chrono::steady_clock::time_point now)
+    {
+        dirty = false;
+        lastScan = now;
+        scans++;
+
+        // The directory may have been created (first save) or replaced since we started watching it
+        if (!watch && useNotifications) OpenWatch();
+
+        std::vector<Entry> scanned;
+        std::error_code ec;
+        for (auto it = std::filesystem::directory_iterator(directory, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+            const auto& ent = *it;
+            if (!ent.is_regular_file(ec) || ent.path().extension() != ".cfg") continue;
+            scanned.push_back(MakeEntry(ent));
+        }
+        std::sort(scanned.begin(), scanned.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+
+        if (scanned != entries) {
+            entries = std::move(scanned);
+            generation++;
+        }
+    }
+
+#ifdef _WIN32
+    void Catalog::OpenWatch()
+    {
+        HANDLE h = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+            FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+        watch = (h == INVALID_HANDLE_VALUE) ? nullptr : h;
+    }
+
+    void Catalog::CloseWatch()
+    {
+        if (watch) FindCloseChangeNotification(static_cast<HANDLE>(watch));
+        watch = nullptr;
+    }
+
+    bool Catalog::WatchSignaled()
+    {
+        const DWORD result = WaitForSingleObject(static_cast<HANDLE>(watch), 0);
+        if (result == WAIT_TIMEOUT) return false;
+        // Re-arm; if that fails (directory deleted) drop back to polling, Rescan() retries the watch
+        if (result != WAIT_OBJECT_0 || !FindNextChangeNotification(static_cast<HANDLE>(watch)))
+            CloseWatch();
+        return true;
+    }
+#else
+    void Catalog::OpenWatch() {}
+    void Catalog::CloseWatch() {}
+    bool Catalog::WatchSignaled() { return false; }
+#endif
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Sorted index of the .cfg files in a directory. Scanned once, then only rescanned after
+// Invalidate() (our own save/delete) or when the directory reports a change: a change
+// notification on Windows, a throttled rescan everywhere else or if the notification fails.
+namespace configcatalog
+{
+    struct Entry {
+        std::string name;                               // file stem, what the menu shows and loads
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+        uint16_t version = 0;                           // configfile format version, 0 for legacy/unknown
+
+        bool operator==(const Entry& other) const;
+    };
+
+    // The entry a scan would record for the file at path right now, name empty if it doesn't exist
+    Entry Stat(const std::filesystem::path& path);
+
+    struct Catalog {
+        std::string directory;
+        std::chrono::milliseconds pollInterval{ 1000 }; // rescan period when there is no notification
+        bool useNotifications = true;                   // false forces the polling fallback
+
+        // Statistics
+        uint64_t scans = 0;
+        uint64_t generation = 0;                        // bumped when the entries actually changed
+
+        explicit Catalog(std::string dir);
+        ~Catalog();
+        Catalog(const Catalog&) = delete;
+        Catalog& operator=(const Catalog&) = delete;
+
+        // Polls for changes and returns the index. No filesystem access while nothing changed.
+        const std::vector<Entry>& Entries();
+
+        // Forces a rescan on the next Poll()/Entries()
+        void Invalidate() { dirty = true; }
+
+        // Rescans if invalidated, notified, or (polling fallback) pollInterval has passed since the
+        // last scan. Returns true if it rescanned.
+        bool Poll(std::chrono::steady_clock::time_point now);
+
+        // Index of name in Entries(), -1 if it isn't there
+        int Find(const std::string& name) const;
+
+        bool IsWatching() const { return watch != nullptr; }
+
+    private:
+        std::vector<Entry> entries;
+        bool dirty = true;
+        std::chrono::steady_clock::time_point lastScan;
+        void* watch = nullptr;                          // change notification handle (Windows only)
+
+        void Rescan(std::chrono::steady_clock::time_point now);
+        void OpenWatch();
+        void CloseWatch();
+        bool WatchSignaled();
+    };
+}
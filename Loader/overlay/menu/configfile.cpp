@@ -0,0 +1,386 @@
+#include "configfile.h"
+#include "menu.h"
+#include "../crosshair.h"
+#include "../platform.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace configfile
+{
+#define CONFIG_FIELD(id, type, section, member) { id, FieldType::type, ConfigSection::section, offsetof(Config, member), #member }
+
+    // Indexed by id - 1. Append only: ids are what older and newer files agree on.
+    static const FieldDesc kFields[] = {
+        CONFIG_FIELD(1,  Bool,      Menu,        menu.vsync),
+        CONFIG_FIELD(2,  Bool,      Menu,        menu.streamproof),
+        CONFIG_FIELD(3,  Bool,      Menu,        menu.drawWatermark),
+        CONFIG_FIELD(4,  Int32,     Menu,        menu.menuKey),
+        CONFIG_FIELD(5,  Bool,      Crosshair,   crosshair.enabled),
+        CONFIG_FIELD(6,  Int32,     Crosshair,   crosshair.size),
+        CONFIG_FIELD(7,  Int32,     Crosshair,   crosshair.thickness),
+        CONFIG_FIELD(8,  Float32x4, Crosshair,   crosshair.color),
+        CONFIG_FIELD(9,  Bool,      Crosshair,   crosshair.rotating),
+        CONFIG_FIELD(10, Bool,      Crosshair,   crosshair.rainbow),
+        CONFIG_FIELD(11, Float32,   Crosshair,   crosshair.rotationSpeed),
+        CONFIG_FIELD(12, Int32,     Crosshair,   crosshair.type),
+        CONFIG_FIELD(13, Bool,      Aimbot,      aimbot.enabled),
+        CONFIG_FIELD(14, Int32,     Aimbot,      aimbot.bone),
+        CONFIG_FIELD(15, Int32,     Aimbot,      aimbot.x),
+        CONFIG_FIELD(16, Int32,     Aimbot,      aimbot.y),
+        CONFIG_FIELD(17, Int32,     Aimbot,      aimbot.key),
+        CONFIG_FIELD(18, Bool,      Autoclicker, autoclicker.enabled),
+        CONFIG_FIELD(19, Int32,     Autoclicker, autoclicker.minCps),
+        CONFIG_FIELD(20, Int32,     Autoclicker, autoclicker.maxCps),
+        CONFIG_FIELD(21, Int32,     Autoclicker, autoclicker.key),
+        CONFIG_FIELD(22, Int32,     Autoclicker, autoclicker.mode),
+        CONFIG_FIELD(23, Bool,      Autoclicker, autoclicker.humanize),
+        CONFIG_FIELD(24, Bool,      Particles,   particles.enabled),
+        CONFIG_FIELD(25, Float32,   Particles,   particles.particleCount),
+        CONFIG_FIELD(26, Float32,   Particles,   particles.particleSpeed),
+        CONFIG_FIELD(27, Float32,   Particles,   particles.particleSize),
+    };
+
+#undef CONFIG_FIELD
+
+    static constexpr uint32_t kFieldCount = static_cast<uint32_t>(sizeof(kFields) / sizeof(kFields[0]));
+    static_assert(kFieldCount <= 64, "Diff::fields has one bit per field id");
+
+    // Raw Config dumps written by older builds (MSVC layout, x86 and x64 alike): { field id, byte offset }.
+    // The first layout had a single autoclicker cps, it seeds both minCps and maxCps.
+    struct LegacyField {
+        uint16_t id;
+        uint16_t offset;
+    };
+
+    static const LegacyField kLegacyV0[] = {
+        { 1, 0 }, { 2, 1 }, { 3, 2 }, { 4, 4 },
+        { 5, 8 }, { 6, 12 }, { 7, 16 }, { 8, 20 }, { 9, 36 }, { 10, 37 }, { 11, 40 }, { 12, 44 },
+        { 13, 48 }, { 14, 52 }, { 15, 56 }, { 16, 60 }, { 17, 64 },
+        { 18, 68 }, { 19, 72 }, { 20, 72 }, { 21, 76 },
+        { 24, 80 }, { 25, 84 }, { 26, 88 }, { 27, 92 },
+    };
+    static constexpr size_t kLegacyV0Size = 96;
+
+    static const LegacyField kLegacyV1[] = {
+        { 1, 0 }, { 2, 1 }, { 3, 2 }, { 4, 4 },
+        { 5, 8 }, { 6, 12 }, { 7, 16 }, { 8, 20 }, { 9, 36 }, { 10, 37 }, { 11, 40 }, { 12, 44 },
+        { 13, 48 }, { 14, 52 }, { 15, 56 }, { 16, 60 }, { 17, 64 },
+        { 18, 68 }, { 19, 72 }, { 20, 76 }, { 21, 80 }, { 22, 84 }, { 23, 88 },
+        { 24, 92 }, { 25, 96 }, { 26, 100 }, { 27, 104 },
+    };
+    static constexpr size_t kLegacyV1Size = 108;
+
+    // Valid range of the numeric fields, inclusive; ints are clamped, floats clamped after NaN/inf is reset
+    // to the default. Float32x4 ranges apply per component. Fields without an entry take any value.
+    struct FieldRange {
+        uint16_t id;
+        float min;
+        float max;
+    };
+
+    static const FieldRange kRanges[] = {
+        { 4,  0.0f, 254.0f },                       // menu.menuKey, a virtual-key code, 0 = no key
+        { 6,  1.0f, 50.0f },                        // crosshair.size, the menu slider's range
+        { 7,  1.0f, 10.0f },                        // crosshair.thickness
+        { 8,  0.0f, 1.0f },                         // crosshair.color
+        { 11, 0.1f, 5.0f },                         // crosshair.rotationSpeed
+        { 12, 0.0f, static_cast<float>(static_cast<int>(crosshair::Shape::Count) - 1) },
+        { 17, 0.0f, 254.0f },                       // aimbot.key
+        { 19, 1.0f, 30.0f },                        // autoclicker.minCps, what ClampAutoclickerRange() allows
+        { 20, 1.0f, 30.0f },                        // autoclicker.maxCps
+        { 21, 0.0f, 254.0f },                       // autoclicker.key
+        { 22, 0.0f, 1.0f },                         // autoclicker.mode: hold, toggle
+        { 25, 0.0f, particles::kMaxCount },         // particles.particleCount
+        { 26, 0.0f, 10.0f },                        // particles.particleSpeed
+        { 27, 0.1f, 10.0f },                        // particles.particleSize
+    };
+
+    static const FieldDesc* FindField(uint16_t id)
+    {
+        return (id >= 1 && id <= kFieldCount) ? &kFields[id - 1] : nullptr;
+    }
+
+    const char* FieldDesc::Name() const
+    {
+        return path + strlen(kConfigSectionNames[static_cast<int>(section)]) + 1;
+    }
+
+    const FieldDesc* Fields(uint32_t* count)
+    {
+        *count = kFieldCount;
+        return kFields;
+    }
+
+    uint8_t TypeSize(FieldType type)
+    {
+        switch (type) {
+        case FieldType::Bool: return 1;
+        case FieldType::Int32: return 4;
+        case FieldType::Float32: return 4;
+        case FieldType::Float32x4: return 16;
+        }
+        return 0;
+    }
+
+    uint32_t Checksum(const void* data, size_t size)
+    {
+        static const auto table = [] {
+            struct { uint32_t v[256]; } t = {};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                t.v[i] = c;
+            }
+            return t;
+        }();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; i++)
+            crc = table.v[(crc ^ static_cast<const uint8_t*>(data)[i]) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    // Bools are stored as one byte; anything non-zero reads back as true
+    static void ReadField(const FieldDesc& field, const uint8_t* src, Config& out)
+    {
+        uint8_t* dst = reinterpret_cast<uint8_t*>(&out) + field.offset;
+        if (field.type == FieldType::Bool)
+            *reinterpret_cast<bool*>(dst) = *src != 0;
+        else
+            memcpy(dst, src, TypeSize(field.type));
+    }
+
+    static void WriteField(const FieldDesc& field, const Config& config, uint8_t* dst)
+    {
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(&config) + field.offset;
+        if (field.type == FieldType::Bool)
+            *dst = *reinterpret_cast<const bool*>(src) ? 1 : 0;
+        else
+            memcpy(dst, src, TypeSize(field.type));
+    }
+
+    Diff Compare(const Config& a, const Config& b)
+    {
+        Diff diff;
+        const uint8_t* pa = reinterpret_cast<const uint8_t*>(&a);
+        const uint8_t* pb = reinterpret_cast<const uint8_t*>(&b);
+        for (const FieldDesc& field : kFields) {
+            // Bools compare as values, everything else bitwise (a float that round-trips through a file is identical)
+            const bool same = field.type == FieldType::Bool
+                ? *reinterpret_cast<const bool*>(pa + field.offset) == *reinterpret_cast<const bool*>(pb + field.offset)
+                : memcmp(pa + field.offset, pb + field.offset, TypeSize(field.type)) == 0;
+            if (same) continue;
+            diff.fields |= 1ull << (field.id - 1);
+            diff.sections |= 1u << static_cast<int>(field.section);
+        }
+        return diff;
+    }
+
+    uint32_t Sanitize(Config& config)
+    {
+        static const Config defaults;
+        uint32_t changed = 0;
+        for (const FieldRange& range : kRanges) {
+            const FieldDesc& field = kFields[range.id - 1];
+            uint8_t* p = reinterpret_cast<uint8_t*>(&config) + field.offset;
+            const uint8_t* def = reinterpret_cast<const uint8_t*>(&defaults) + field.offset;
+            if (field.type == FieldType::Int32) {
+                int32_t value;
+                memcpy(&value, p, sizeof(value));
+                const int32_t clamped = std::clamp(value, static_cast<int32_t>(range.min), static_cast<int32_t>(range.max));
+                if (clamped == value) continue;
+                memcpy(p, &clamped, sizeof(clamped));
+                changed++;
+                continue;
+            }
+            const int components = field.type == FieldType::Float32x4 ? 4 : 1;
+            bool fieldChanged = false;
+            for (int i = 0; i < components; i++) {
+                float value, fallback;
+                memcpy(&value, p + i * sizeof(float), sizeof(value));
+                memcpy(&fallback, def + i * sizeof(float), sizeof(fallback));
+                const float fixed = std::isfinite(value) ? std::clamp(value, range.min, range.max) : fallback;
+                if (memcmp(&fixed, &value, sizeof(value)) == 0) continue;
+                memcpy(p + i * sizeof(float), &fixed, sizeof(fixed));
+                fieldChanged = true;
+            }
+            changed += fieldChanged ? 1 : 0;
+        }
+        if (config.autoclicker.maxCps < config.autoclicker.minCps) {
+            config.autoclicker.maxCps = config.autoclicker.minCps;
+            changed++;
+        }
+        return changed;
+    }
+
+    void ApplyDiff(Config& dst, const Config& src, const Diff& diff)
+    {
+        for (const FieldDesc& field : kFields) {
+            if (!(diff.fields & (1ull << (field.id - 1)))) continue;
+            memcpy(reinterpret_cast<uint8_t*>(&dst) + field.offset, reinterpret_cast<const uint8_t*>(&src) + field.offset, TypeSize(field.type));
+        }
+    }
+
+    const char* StatusName(Status status)
+    {
+        switch (status) {
+        case Status::Ok: return "ok";
+        case Status::Legacy: return "legacy";
+        case Status::NotFound: return "not found";
+        case Status::Empty: return "empty";
+        case Status::BadMagic: return "unknown format";
+        case Status::UnsupportedVersion: return "unsupported version";
+        case Status::Truncated: return "truncated";
+        case Status::ChecksumMismatch: return "checksum mismatch";
+        }
+        return "?";
+    }
+
+    Status View::Validate(const void* data, size_t size)
+    {
+        header = nullptr;
+        payload = nullptr;
+        payloadSize = 0;
+
+        if (size < sizeof(Header)) return Status::Truncated;
+        const Header* h = static_cast<const Header*>(data);
+        if (h->magic != kMagic) return Status::BadMagic;
+        // Newer versions may grow the header, the records stay readable
+        if (h->version == 0 || h->headerSize < sizeof(Header)) return Status::UnsupportedVersion;
+        if (h->headerSize > size || h->payloadSize > size - h->headerSize) return Status::Truncated;
+
+        const uint8_t* p = static_cast<const uint8_t*>(data) + h->headerSize;
+        if (Checksum(p, h->payloadSize) != h->crc32) return Status::ChecksumMismatch;
+
+        // Every record has to fit, so Apply() can walk them unchecked
+        size_t pos = 0;
+        for (uint32_t i = 0; i < h->fieldCount; i++) {
+            if (h->payloadSize - pos < sizeof(RecordHeader)) return Status::Truncated;
+            const RecordHeader* rec = reinterpret_cast<const RecordHeader*>(p + pos);
+            pos += sizeof(RecordHeader);
+            if (h->payloadSize - pos < rec->size) return Status::Truncated;
+            pos += rec->size;
+        }
+        if (pos != h->payloadSize) return Status::Truncated;
+
+        header = h;
+        payload = p;
+        payloadSize = h->payloadSize;
+        return Status::Ok;
+    }
+
+    void View::Apply(Config& out, LoadResult& result) const
+    {
+        const uint8_t* p = payload;
+        for (uint32_t i = 0; i < header->fieldCount; i++) {
+            RecordHeader rec;
+            memcpy(&rec, p, sizeof(rec));
+            p += sizeof(rec);
+            const FieldDesc* field = FindField(rec.id);
+            if (field && field->type == rec.type && TypeSize(rec.type) == rec.size) {
+                ReadField(*field, p, out);
+                result.applied++;
+            } else {
+                result.skipped++;
+            }
+            p += rec.size;
+        }
+    }
+
+    template <size_t N>
+    static void ApplyLegacy(const LegacyField (&layout)[N], const uint8_t* data, Config& out, LoadResult& result)
+    {
+        for (const LegacyField& legacy : layout) {
+            ReadField(*FindField(legacy.id), data + legacy.offset, out);
+            result.applied++;
+        }
+    }
+
+    LoadResult Parse(const void* data, size_t size, Config& out)
+    {
+        LoadResult result;
+        if (size == 0) {
+            result.status = Status::Empty;
+            return result;
+        }
+
+        // Fields the file doesn't have get their defaults, not whatever the current config holds
+        Config tmp;
+        View view;
+        result.status = view.Validate(data, size);
+        if (result.status == Status::Ok) {
+            result.version = view.header->version;
+            view.Apply(tmp, result);
+        } else if (result.status == Status::BadMagic) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            if (size == kLegacyV0Size)
+                ApplyLegacy(kLegacyV0, bytes, tmp, result);
+            else if (size == kLegacyV1Size)
+                ApplyLegacy(kLegacyV1, bytes, tmp, result);
+            else
+                return result;
+            result.status = Status::Legacy;
+        } else {
+            return result;
+        }
+
+        result.clamped = Sanitize(tmp);
+        out = tmp;
+        return result;
+    }
+
+    LoadResult Load(const std::string& path, Config& out)
+    {
+        platform::MappedFile mapped(path);
+        if (!mapped.opened) {
+            LoadResult result;
+            result.status = Status::NotFound;
+            return result;
+        }
+        return Parse(mapped.data, mapped.size, out);
+    }
+
+    uint16_t ProbeVersion(const std::string& path)
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        Header header;
+        if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header))) return 0;
+        return header.magic == kMagic ? header.version : 0;
+    }
+
+    void Serialize(const Config& config, std::vector<uint8_t>& out)
+    {
+        size_t payloadSize = 0;
+        for (const FieldDesc& field : kFields)
+            payloadSize += sizeof(RecordHeader) + TypeSize(field.type);
+
+        out.assign(sizeof(Header) + payloadSize, 0);
+        uint8_t* p = out.data() + sizeof(Header);
+        for (const FieldDesc& field : kFields) {
+            RecordHeader rec = { field.id, field.type, TypeSize(field.type) };
+            memcpy(p, &rec, sizeof(rec));
+            p += sizeof(rec);
+            WriteField(field, config, p);
+            p += rec.size;
+        }
+
+        Header header;
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.headerSize = sizeof(Header);
+        header.fieldCount = kFieldCount;
+        header.payloadSize = static_cast<uint32_t>(payloadSize);
+        header.crc32 = Checksum(out.data() + sizeof(Header), payloadSize);
+        memcpy(out.data(), &header, sizeof(header));
+    }
+
+    bool Save(const std::string& path, const Config& config)
+    {
+        std::vector<uint8_t> bytes;
+        Serialize(config, bytes);
+
+        return platform::WriteFileDurable(path, bytes.data(), bytes.size());
+    }
+}
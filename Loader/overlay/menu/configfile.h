@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Config;
+enum class ConfigSection : int;
+
+// On-disk config format. A file is a fixed header followed by one tagged record per field:
+//   Header  { magic 'ONIC', version, headerSize, fieldCount, payloadSize, crc32 of the payload }
+//   Record  { uint16 id, uint8 type, uint8 size, <size> bytes }
+// Field ids are stable and never reused. Unknown ids (written by a newer build) and records whose
+// type doesn't match are skipped, fields missing from the file (written by an older build) keep
+// their defaults. Files without the magic are read as the raw Config dumps older builds wrote.
+namespace configfile
+{
+    inline constexpr uint32_t kMagic = 0x43494E4F; // "ONIC"
+    inline constexpr uint16_t kVersion = 1;
+
+    enum class FieldType : uint8_t {
+        Bool = 1,
+        Int32 = 2,
+        Float32 = 3,
+        Float32x4 = 4,
+    };
+
+    // One per Config field. path is the member path ("crosshair.size"), name the part after the section.
+    struct FieldDesc {
+        uint16_t id;
+        FieldType type;
+        ConfigSection section;
+        size_t offset;
+        const char* path;
+
+        const char* Name() const;
+    };
+
+    // Every field, ordered by id (fields[i].id == i + 1)
+    const FieldDesc* Fields(uint32_t* count);
+
+    // Bytes of a field value in memory and in a record (bools are stored as one byte)
+    uint8_t TypeSize(FieldType type);
+
+#pragma pack(push, 1)
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t fieldCount;
+        uint32_t payloadSize;
+        uint32_t crc32;
+    };
+
+    struct RecordHeader {
+        uint16_t id;
+        FieldType type;
+        uint8_t size;
+    };
+#pragma pack(pop)
+
+    enum class Status {
+        Ok,
+        Legacy,            // raw Config dump from before the tagged format, converted field by field
+        NotFound,
+        Empty,
+        BadMagic,          // neither the tagged format nor a known raw layout
+        UnsupportedVersion,
+        Truncated,
+        ChecksumMismatch,
+    };
+
+    const char* StatusName(Status status);
+
+    struct LoadResult {
+        Status status = Status::NotFound;
+        uint16_t version = 0;       // 0 for legacy files
+        uint32_t applied = 0;       // fields copied into the config
+        uint32_t skipped = 0;       // unknown ids or mismatched types
+        uint32_t clamped = 0;       // out-of-range values pulled into range by Sanitize()
+
+        bool ok() const { return status == Status::Ok || status == Status::Legacy; }
+    };
+
+    // Validated view over a mapped file. Validate() checks the header, the record bounds and the
+    // checksum once; Apply() then walks the records without further checks or allocations.
+    struct View {
+        const Header* header = nullptr;
+        const uint8_t* payload = nullptr;
+        size_t payloadSize = 0;
+
+        Status Validate(const void* data, size_t size);
+        void Apply(Config& out, LoadResult& result) const;
+    };
+
+    // Pulls every numeric field into the range the menu, the overlay and the particle pool can handle:
+    // NaN/inf floats take their default, sizes, counts, keys and enum values are clamped, and maxCps
+    // is raised to minCps. Returns the number of fields it changed. Every load path runs it.
+    uint32_t Sanitize(Config& config);
+
+    // Parses an in-memory file (tagged or legacy) into out, sanitized. out is only written if the file is valid.
+    LoadResult Parse(const void* data, size_t size, Config& out);
+
+    // Maps the file read-only and parses it
+    LoadResult Load(const std::string& path, Config& out);
+
+    // Format version from the header alone (no checksum), 0 for legacy or unreadable files
+    uint16_t ProbeVersion(const std::string& path);
+
+    void Serialize(const Config& config, std::vector<uint8_t>& out);
+
+    // Field-level difference between two configs
+    struct Diff {
+        uint64_t fields = 0;    // bit (id - 1) for every field that differs
+        uint32_t sections = 0;  // bit ConfigSection for every section with at least one differing field
+
+        bool Empty() const { return fields == 0; }
+        bool Has(ConfigSection section) const { return (sections >> static_cast<int>(section)) & 1u; }
+    };
+
+    Diff Compare(const Config& a, const Config& b);
+
+    // Copies only the fields in diff from src into dst
+    void ApplyDiff(Config& dst, const Config& src, const Diff& diff);
+
+    // CRC-32 (IEEE) as stored in Header::crc32
+    uint32_t Checksum(const void* data, size_t size);
+
+    // Writes to path + ".tmp", flushes it and renames it over path (platform::WriteFileDurable), so neither a
+    // failed save nor a crash right after one leaves a half-written config
+    bool Save(const std::string& path, const Config& config);
+}
@@ -0,0 +1,245 @@
+#include "configio.h"
+#include "configjson.h"
+#include "menu.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+namespace configio
+{
+    Worker::Worker(std::string dir)
+        : directory(std::move(dir))
+    {
+    }
+
+    Worker::~Worker()
+    {
+        Stop();
+    }
+
+    std::string Worker::Path(const std::string& name) const
+    {
+        return directory + "/" + name + ".cfg";
+    }
+
+    std::string Worker::JsonPath(const std::string& name) const
+    {
+        return directory + "/" + name + ".json";
+    }
+
+    void Worker::Save(const std::string& name, const Config& config)
+    {
+        Enqueue({ Op::Save, name, std::make_unique<Config>(config) });
+    }
+
+    void Worker::Load(const std::string& name)
+    {
+        Enqueue({ Op::Load, name, nullptr });
+    }
+
+    void Worker::Reload(const std::string& name)
+    {
+        Enqueue({ Op::Reload, name, nullptr });
+    }
+
+    void Worker::Delete(const std::string& name)
+    {
+        Enqueue({ Op::Delete, name, nullptr });
+    }
+
+    void Worker::ExportJson(const std::string& name, const Config& config)
+    {
+        Enqueue({ Op::ExportJson, name, std::make_unique<Config>(config) });
+    }
+
+    void Worker::ImportJson(const std::string& name)
+    {
+        Enqueue({ Op::ImportJson, name, nullptr });
+    }
+
+    void Worker::Enqueue(Job job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!thread.joinable()) {
+            stopping = false;
+            jobs.push_back({ Op::Recover, std::string(), nullptr });
+            thread = std::thread(&Worker::Run, this);
+        }
+        // A save still waiting at the back of the queue is superseded by a newer save of the same name
+        if (job.op == Op::Save && !jobs.empty() && jobs.back().op == Op::Save && jobs.back().name == job.name) {
+            jobs.back().config = std::move(job.config);
+            jobs.back().saves += job.saves;
+            return;
+        }
+        jobs.push_back(std::move(job));
+        wake.notify_one();
+    }
+
+    bool Worker::Poll(Completion& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (done.empty()) return false;
+        out = std::move(done.front());
+        done.pop_front();
+        return true;
+    }
+
+    size_t Worker::Pending()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobs.size() + running;
+    }
+
+    void Worker::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (thread.joinable()) thread.join();
+    }
+
+    void Worker::Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // stopping, and everything queued has been written
+
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            running++;
+            lock.unlock();
+            Completion result = Execute(job);
+            lock.lock();
+            running--;
+            done.push_back(std::move(result));
+        }
+    }
+
+    Completion Worker::Execute(Job& job)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Completion result;
+        result.op = job.op;
+        result.name = job.name;
+
+        switch (job.op) {
+        case Op::Save: {
+            std::error_code ec;
+            std::filesystem::create_directories(directory, ec);
+            result.ok = configfile::Save(Path(job.name), *job.config);
+            result.saves = job.saves;
+            if (result.ok) {
+                result.file = configcatalog::Stat(Path(job.name));
+                result.config = std::move(job.config);
+            }
+            break;
+        }
+        case Op::Load:
+        case Op::Reload:
+            result.file = configcatalog::Stat(Path(job.name));
+            result.config = std::make_unique<Config>();
+            result.load = configfile::Load(Path(job.name), *result.config);
+            result.ok = result.load.ok();
+            if (!result.ok) result.config.reset();
+            break;
+        case Op::Delete: {
+            std::error_code ec;
+            result.ok = std::filesystem::remove(Path(job.name), ec);
+            break;
+        }
+        case Op::ExportJson: {
+            std::error_code ec;
+            std::filesystem::create_directories(directory, ec);
+            result.ok = configjson::SaveFile(JsonPath(job.name), *job.config);
+            break;
+        }
+        case Op::ImportJson: {
+            result.config = std::make_unique<Config>();
+            const configjson::ImportResult imported = configjson::LoadFile(JsonPath(job.name), *result.config);
+            result.ok = imported.ok;
+            result.error = imported.error;
+            if (!result.ok) result.config.reset();
+            break;
+        }
+        case Op::Recover: {
+            const Completion recovered = RecoverDirectory(directory);
+            result.ok = recovered.ok;
+            result.recovered = recovered.recovered;
+            result.discarded = recovered.discarded;
+            break;
+        }
+        }
+
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    void ActiveFile::Saved(const Completion& done)
+    {
+        savesInFlight -= std::min(done.saves, savesInFlight);
+        if (!done.ok) return;
+        name = done.name;
+        image = *done.config;
+        entry = done.file;
+    }
+
+    void ActiveFile::Loaded(const Completion& done)
+    {
+        name = done.name;
+        image = *done.config;
+        entry = done.file;
+    }
+
+    configfile::Diff ActiveFile::Reloaded(const Completion& done, Config& live)
+    {
+        const configfile::Diff diff = configfile::Compare(image, *done.config);
+        configfile::ApplyDiff(live, *done.config, diff);
+        image = *done.config;
+        entry = done.file;
+        return diff;
+    }
+
+    bool ActiveFile::Changed(const configcatalog::Entry* current)
+    {
+        // Deleted: a re-created file will differ from entry
+        if (name.empty() || !current || *current == entry) return false;
+        if (savesInFlight > 0) return false;
+        entry = *current;
+        return true;
+    }
+
+    Completion RecoverDirectory(const std::string& dir)
+    {
+        Completion result;
+        result.op = Op::Recover;
+        result.ok = true;
+
+        std::error_code ec;
+        std::vector<std::filesystem::path> temps;
+        for (auto it = std::filesystem::directory_iterator(dir, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+            const auto& path = it->path();
+            if (path.extension() == ".tmp" && path.stem().extension() == ".cfg")
+                temps.push_back(path);
+        }
+
+        for (const auto& temp : temps) {
+            const std::filesystem::path target = temp.parent_path() / temp.stem(); // name.cfg
+            Config scratch;
+            const bool targetOk = configfile::Load(target.string(), scratch).ok();
+            const bool tempOk = !targetOk && configfile::Load(temp.string(), scratch).status == configfile::Status::Ok;
+            if (tempOk) {
+                std::filesystem::rename(temp, target, ec);
+                if (ec) result.ok = false;
+                else result.recovered++;
+            } else {
+                std::filesystem::remove(temp, ec);
+                if (ec) result.ok = false;
+                else result.discarded++;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "configcatalog.h"
+#include "configfile.h"
+#include "menu.h"
+
+// Background worker for config file I/O, so a slow (or AV-scanned) disk never stalls the render
+// thread. Requests are queued from the UI and run in order on one thread; results come back
+// through a completion queue that the render thread drains once per frame with Poll().
+namespace configio
+{
+    enum class Op {
+        Save,
+        Load,
+        Reload,     // same as Load, for a file that changed on disk
+        Delete,
+        ExportJson, // name.json next to the .cfg files
+        ImportJson,
+        Recover,
+    };
+
+    struct Completion {
+        Op op = Op::Save;
+        std::string name;
+        bool ok = false;
+        configfile::LoadResult load;        // Op::Load/Reload only
+        std::string error;                  // Op::ImportJson: parse error
+        std::unique_ptr<Config> config;     // Op::Load/Reload/ImportJson: the parsed config, ready to swap in; Op::Save: what was written
+        configcatalog::Entry file;          // Op::Save/Load/Reload: the file right after writing it / right before reading it
+        uint32_t saves = 1;                 // Op::Save: Save() calls this write covers, later ones coalesce into a queued save
+        uint32_t recovered = 0;             // Op::Recover: temp files promoted over a damaged config
+        uint32_t discarded = 0;             // Op::Recover: stale temp files removed
+        double ms = 0.0;
+    };
+
+    struct Worker {
+        explicit Worker(std::string dir);
+        ~Worker();
+        Worker(const Worker&) = delete;
+        Worker& operator=(const Worker&) = delete;
+
+        // The thread starts with the first request, which is always preceded by a Recover pass
+        // over the directory. A save takes a copy of config, later edits don't affect it.
+        void Save(const std::string& name, const Config& config);
+        void Load(const std::string& name);
+        void Reload(const std::string& name);
+        void Delete(const std::string& name);
+        void ExportJson(const std::string& name, const Config& config);
+        void ImportJson(const std::string& name);
+
+        // Moves one finished request into out. Render thread, once or more per frame.
+        bool Poll(Completion& out);
+
+        // Requests queued or running
+        size_t Pending();
+
+        // Finishes every queued request (pending saves are not dropped) and joins the thread.
+        // Completions stay available to Poll().
+        void Stop();
+
+        std::string Path(const std::string& name) const;
+        std::string JsonPath(const std::string& name) const;
+
+    private:
+        struct Job {
+            Op op;
+            std::string name;
+            std::unique_ptr<Config> config;   // Op::Save snapshot
+            uint32_t saves = 1;               // Op::Save: Save() calls coalesced into this job
+        };
+
+        std::string directory;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Job> jobs;
+        std::deque<Completion> done;
+        size_t running = 0;
+        bool stopping = false;
+        std::thread thread;
+
+        void Enqueue(Job job);
+        void Run();
+        Completion Execute(Job& job);
+    };
+
+    // The config the menu last loaded or saved, and what its file held at that point. When the file changes
+    // on disk, only the fields where the new file differs from image are applied, so edits made in the menu
+    // since then survive the reload. Our own writes are told apart by the entry the worker took right after
+    // the rename; while a save is still in flight a changed entry waits for it, because the directory can
+    // report the write before the save's completion has been polled.
+    struct ActiveFile {
+        std::string name;                   // empty: no active config, nothing is watched
+        Config image;
+        configcatalog::Entry entry;         // the file as we last read or wrote it
+        uint32_t savesInFlight = 0;
+
+        // Call for every Worker::Save()
+        void Saving() { savesInFlight++; }
+
+        // Completion handlers. Loaded() before done.config is swapped in; Reloaded() applies the file's
+        // changes to live and returns them, for a completed reload of this file.
+        void Saved(const Completion& done);
+        void Loaded(const Completion& done);
+        configfile::Diff Reloaded(const Completion& done, Config& live);
+
+        // current: the catalog's entry for name, nullptr if the file is gone. True if it changed under us
+        // and a reload should be queued (at most once per change).
+        bool Changed(const configcatalog::Entry* current);
+    };
+
+    // Promotes name.cfg.tmp over name.cfg when the .cfg is missing or damaged and the temp file is
+    // complete, otherwise deletes the temp file. Covers a save interrupted before or during rename.
+    Completion RecoverDirectory(const std::string& dir);
+}
@@ -0,0 +1,391 @@
+#include "configjson.h"
+#include "configfile.h"
+#include "menu.h"
+#include "../platform.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <json.hpp>
+
+namespace configjson
+{
+    using json = nlohmann::json;
+
+    static uint8_t* FieldPtr(Config& config, const configfile::FieldDesc& field)
+    {
+        return reinterpret_cast<uint8_t*>(&config) + field.offset;
+    }
+
+    static const configfile::FieldDesc* FindField(int section, const std::string& name)
+    {
+        uint32_t count = 0;
+        const configfile::FieldDesc* fields = configfile::Fields(&count);
+        for (uint32_t i = 0; i < count; i++)
+            if (static_cast<int>(fields[i].section) == section && name == fields[i].Name())
+                return &fields[i];
+        return nullptr;
+    }
+
+    static int FindSection(const std::string& name)
+    {
+        for (int section = 0; section < static_cast<int>(ConfigSection::Count); section++)
+            if (name == kConfigSectionNames[section])
+                return section;
+        return -1;
+    }
+
+    // A JSON scalar on its way into a field; both importers funnel through Assign()
+    struct Scalar {
+        enum Kind { Bool, Integer, Float } kind;
+        bool b = false;
+        int64_t i = 0;
+        double d = 0.0;
+    };
+
+    static bool ToFloat(const Scalar& value, float& out)
+    {
+        if (value.kind == Scalar::Integer) { out = static_cast<float>(value.i); return true; }
+        if (value.kind == Scalar::Float && std::isfinite(value.d)) { out = static_cast<float>(value.d); return true; }
+        return false;
+    }
+
+    static bool Assign(Config& config, const configfile::FieldDesc& field, int component, const Scalar& value)
+    {
+        uint8_t* dst = FieldPtr(config, field);
+        switch (field.type) {
+        case configfile::FieldType::Bool:
+            if (value.kind != Scalar::Bool || component >= 0) return false;
+            *reinterpret_cast<bool*>(dst) = value.b;
+            return true;
+        case configfile::FieldType::Int32: {
+            int64_t v = value.i;
+            if (value.kind == Scalar::Float) {
+                if (!(value.d >= INT_MIN && value.d <= INT_MAX) || std::floor(value.d) != value.d) return false;
+                v = static_cast<int64_t>(value.d);
+            } else if (value.kind != Scalar::Integer || v < INT_MIN || v > INT_MAX) {
+                return false;
+            }
+            if (component >= 0) return false;
+            const int32_t i = static_cast<int32_t>(v);
+            memcpy(dst, &i, sizeof(i));
+            return true;
+        }
+        case configfile::FieldType::Float32: {
+            float f;
+            if (component >= 0 || !ToFloat(value, f)) return false;
+            memcpy(dst, &f, sizeof(f));
+            return true;
+        }
+        case configfile::FieldType::Float32x4: {
+            float f;
+            if (component < 0 || component >= 4 || !ToFloat(value, f)) return false;
+            memcpy(dst + component * sizeof(float), &f, sizeof(f));
+            return true;
+        }
+        }
+        return false;
+    }
+
+    // Streams the document into a Config. Nesting: root object (depth 1) > section objects (depth 2) >
+    // color arrays (depth 3). Anything else is skipped as a whole.
+    class ConfigSax final : public nlohmann::json_sax<json> {
+    public:
+        ConfigSax(Config& out, ImportResult& result) : out(out), result(result) {}
+
+        bool null() override { return Value(nullptr); }
+        bool boolean(bool val) override { Scalar s{ Scalar::Bool }; s.b = val; return Value(&s); }
+        bool number_integer(number_integer_t val) override { Scalar s{ Scalar::Integer }; s.i = val; return Value(&s); }
+        bool number_unsigned(number_unsigned_t val) override
+        {
+            Scalar s{ Scalar::Integer };
+            s.i = val > static_cast<number_unsigned_t>(INT64_MAX) ? INT64_MAX : static_cast<int64_t>(val);
+            return Value(&s);
+        }
+        bool number_float(number_float_t val, const string_t&) override { Scalar s{ Scalar::Float }; s.d = val; return Value(&s); }
+        bool binary(binary_t&) override { return Value(nullptr); }
+
+        bool string(string_t& val) override
+        {
+            if (skipDepth == 0 && depth == 1 && rootKey == RootKey::Format) {
+                if (val != kFormat) {
+                    result.error = "not an " + std::string(kFormat) + " document";
+                    return false;
+                }
+                formatSeen = true;
+                return true;
+            }
+            return Value(nullptr);
+        }
+
+        bool start_object(std::size_t) override
+        {
+            if (skipDepth == 0) {
+                if (depth == 0) { depth = 1; return true; }
+                if (depth == 1 && rootKey == RootKey::Section) { depth = 2; return true; }
+            }
+            return StartSkip();
+        }
+
+        bool start_array(std::size_t) override
+        {
+            if (skipDepth == 0 && depth == 2 && field && field->type == configfile::FieldType::Float32x4) {
+                depth = 3;
+                component = 0;
+                return true;
+            }
+            return StartSkip();
+        }
+
+        bool end_object() override { return End(); }
+        bool end_array() override { return End(); }
+
+        bool key(string_t& val) override
+        {
+            if (skipDepth != 0) return true;
+            if (depth == 1) {
+                field = nullptr;
+                if (val == "format") rootKey = RootKey::Format;
+                else if (val == "version") rootKey = RootKey::Version;
+                else if ((section = FindSection(val)) >= 0) rootKey = RootKey::Section;
+                else rootKey = RootKey::Unknown;
+            } else if (depth == 2) {
+                field = FindField(section, val);
+                if (!field) result.skipped++;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override
+        {
+            result.error = ex.what();
+            return false;
+        }
+
+        bool formatSeen = false;
+
+    private:
+        enum class RootKey { Unknown, Format, Version, Section };
+
+        Config& out;
+        ImportResult& result;
+        int depth = 0;
+        int skipDepth = 0;
+        RootKey rootKey = RootKey::Unknown;
+        int section = -1;
+        const configfile::FieldDesc* field = nullptr;
+        int component = -1;
+
+        bool StartSkip()
+        {
+            if (skipDepth == 0 && !(depth == 2 && !field)) result.skipped++;
+            skipDepth++;
+            return true;
+        }
+
+        bool End()
+        {
+            if (skipDepth > 0) { skipDepth--; return true; }
+            if (depth == 3) component = -1;
+            else if (depth == 2) field = nullptr;
+            depth--;
+            return true;
+        }
+
+        bool Value(const Scalar* value)
+        {
+            if (skipDepth != 0) return true;
+            if (depth == 1) {
+                if (rootKey == RootKey::Version && value && value->kind == Scalar::Integer) result.version = static_cast<int>(value->i);
+                else if (rootKey != RootKey::Unknown) result.skipped++;
+                return true;
+            }
+            if (depth == 2 && field) {
+                if (value && Assign(out, *field, -1, *value)) result.applied++;
+                else result.skipped++;
+                return true;
+            }
+            if (depth == 3) {
+                if (value && Assign(out, *field, component, *value)) result.applied++;
+                else result.skipped++;
+                component++;
+            }
+            return true;
+        }
+    };
+
+    ImportResult Import(const char* text, size_t size, Config& out)
+    {
+        ImportResult result;
+        Config tmp;
+        ConfigSax sax(tmp, result);
+        const bool parsed = json::sax_parse(text, text + size, &sax);
+        if (parsed && !sax.formatSeen) result.error = "missing \"format\"";
+        result.ok = parsed && sax.formatSeen;
+        if (!result.ok) return result;
+        result.clamped = configfile::Sanitize(tmp);
+        out = tmp;
+        return result;
+    }
+
+    static bool ToScalar(const json& value, Scalar& out)
+    {
+        if (value.is_boolean()) { out.kind = Scalar::Bool; out.b = value.get<bool>(); return true; }
+        if (value.is_number_integer()) {
+            out.kind = Scalar::Integer;
+            out.i = value.is_number_unsigned() && value.get<uint64_t>() > static_cast<uint64_t>(INT64_MAX) ? INT64_MAX : value.get<int64_t>();
+            return true;
+        }
+        if (value.is_number_float()) { out.kind = Scalar::Float; out.d = value.get<double>(); return true; }
+        return false;
+    }
+
+    ImportResult ImportDom(const char* text, size_t size, Config& out)
+    {
+        ImportResult result;
+        const json doc = json::parse(text, text + size, nullptr, false);
+        if (doc.is_discarded() || !doc.is_object()) {
+            result.error = "parse error";
+            return result;
+        }
+        const auto format = doc.find("format");
+        if (format == doc.end() || !format->is_string() || format->get_ref<const std::string&>() != kFormat) {
+            result.error = "not an " + std::string(kFormat) + " document";
+            return result;
+        }
+        const auto version = doc.find("version");
+        if (version != doc.end() && version->is_number_integer()) result.version = version->get<int>();
+
+        Config tmp;
+        for (const auto& [sectionName, sectionValue] : doc.items()) {
+            const int section = FindSection(sectionName);
+            if (section < 0) {
+                if (sectionName != "format" && sectionName != "version") result.skipped++;
+                continue;
+            }
+            if (!sectionValue.is_object()) { result.skipped++; continue; }
+            for (const auto& [fieldName, value] : sectionValue.items()) {
+                const configfile::FieldDesc* field = FindField(section, fieldName);
+                Scalar scalar{ Scalar::Bool };
+                if (!field) {
+                    result.skipped++;
+                } else if (value.is_array() && field->type == configfile::FieldType::Float32x4) {
+                    for (size_t i = 0; i < value.size(); i++) {
+                        if (ToScalar(value[i], scalar) && Assign(tmp, *field, static_cast<int>(i), scalar)) result.applied++;
+                        else result.skipped++;
+                    }
+                } else if (ToScalar(value, scalar) && Assign(tmp, *field, -1, scalar)) {
+                    result.applied++;
+                } else {
+                    result.skipped++;
+                }
+            }
+        }
+        result.ok = true;
+        result.clamped = configfile::Sanitize(tmp);
+        out = tmp;
+        return result;
+    }
+
+    static void AppendFloat(std::string& out, float value)
+    {
+        // JSON has no NaN/inf; null reads back as "keep the default"
+        if (!std::isfinite(value)) {
+            out += "null";
+            return;
+        }
+        char buffer[32];
+        const auto res = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, res.ptr);
+        // Keep it a JSON float so a reader can tell 1.0 from 1
+        if (std::find_if(buffer, res.ptr, [](char c) { return c == '.' || c == 'e'; }) == res.ptr)
+            out += ".0";
+    }
+
+    std::string Export(const Config& config)
+    {
+        uint32_t count = 0;
+        const configfile::FieldDesc* fields = configfile::Fields(&count);
+
+        std::string out;
+        out.reserve(1024);
+        out += "{\n    \"format\": \"";
+        out += kFormat;
+        out += "\",\n    \"version\": ";
+        out += std::to_string(kVersion);
+
+        int openSection = -1;
+        for (uint32_t i = 0; i < count; i++) {
+            const configfile::FieldDesc& field = fields[i];
+            const int section = static_cast<int>(field.section);
+            if (section != openSection) {
+                if (openSection >= 0) out += "\n    }";
+                out += ",\n    \"";
+                out += kConfigSectionNames[section];
+                out += "\": {\n";
+                openSection = section;
+            } else {
+                out += ",\n";
+            }
+            out += "        \"";
+            out += field.Name();
+            out += "\": ";
+
+            const uint8_t* src = reinterpret_cast<const uint8_t*>(&config) + field.offset;
+            switch (field.type) {
+            case configfile::FieldType::Bool:
+                out += *reinterpret_cast<const bool*>(src) ? "true" : "false";
+                break;
+            case configfile::FieldType::Int32: {
+                int32_t v;
+                memcpy(&v, src, sizeof(v));
+                out += std::to_string(v);
+                break;
+            }
+            case configfile::FieldType::Float32: {
+                float v;
+                memcpy(&v, src, sizeof(v));
+                AppendFloat(out, v);
+                break;
+            }
+            case configfile::FieldType::Float32x4: {
+                out += "[ ";
+                for (int c = 0; c < 4; c++) {
+                    float v;
+                    memcpy(&v, src + c * sizeof(float), sizeof(v));
+                    if (c) out += ", ";
+                    AppendFloat(out, v);
+                }
+                out += " ]";
+                break;
+            }
+            }
+        }
+        if (openSection >= 0) out += "\n    }";
+        out += "\n}\n";
+        return out;
+    }
+
+    bool SaveFile(const std::string& path, const Config& config)
+    {
+        const std::string text = Export(config);
+        return platform::WriteFileDurable(path, text.data(), text.size());
+    }
+
+    ImportResult LoadFile(const std::string& path, Config& out)
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs) {
+            ImportResult result;
+            result.error = "not found";
+            return result;
+        }
+        const std::vector<char> text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        return Import(text.data(), text.size(), out);
+    }
+}
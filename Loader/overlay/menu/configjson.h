@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct Config;
+
+// Human-readable JSON export/import of Config, on top of the vendored nlohmann json.hpp.
+//   { "format": "oni-config", "version": 1, "menu": { "vsync": true, ... }, "crosshair": { ... }, ... }
+// Section and field names come from the configfile field table, so the binary and JSON formats
+// always cover the same fields. Import streams through the SAX interface straight into a Config,
+// no DOM is built. Unknown keys and values of the wrong type are skipped, missing fields keep
+// their defaults.
+namespace configjson
+{
+    inline constexpr const char* kFormat = "oni-config";
+    inline constexpr int kVersion = 1;
+
+    struct ImportResult {
+        bool ok = false;
+        std::string error;      // parse error or format mismatch, empty if ok
+        int version = 0;
+        uint32_t applied = 0;   // fields (color components count once per component) copied into the config
+        uint32_t skipped = 0;   // unknown keys, out-of-range or mistyped values
+        uint32_t clamped = 0;   // values pulled into range by configfile::Sanitize()
+    };
+
+    // Pretty-printed, sections and fields in id order, floats in their shortest round-trip form
+    std::string Export(const Config& config);
+
+    // SAX import, sanitized like a binary load. out is only written if the whole document parsed.
+    ImportResult Import(const char* text, size_t size, Config& out);
+
+    // Same result through json::parse and the DOM, kept as the benchmark baseline
+    ImportResult ImportDom(const char* text, size_t size, Config& out);
+
+    bool SaveFile(const std::string& path, const Config& config);
+    ImportResult LoadFile(const std::string& path, Config& out);
+}
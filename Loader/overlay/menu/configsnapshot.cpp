@@ -0,0 +1,80 @@
+#include "configsnapshot.h"
+#include <utility>
+
+namespace configsnapshot
+{
+    Snapshot::Snapshot(Snapshot&& other) noexcept
+        : readers(std::exchange(other.readers, nullptr)), data(std::exchange(other.data, nullptr)), version(other.version)
+    {
+    }
+
+    Snapshot& Snapshot::operator=(Snapshot&& other) noexcept
+    {
+        if (this != &other) {
+            Release();
+            readers = std::exchange(other.readers, nullptr);
+            data = std::exchange(other.data, nullptr);
+            version = other.version;
+        }
+        return *this;
+    }
+
+    Snapshot::~Snapshot()
+    {
+        Release();
+    }
+
+    void Snapshot::Release()
+    {
+        if (readers) readers->fetch_sub(1);
+        readers = nullptr;
+        data = nullptr;
+    }
+
+    Holder::Holder(const Config& initial)
+    {
+        slots[0].config = initial;
+        slots[0].version = 1;
+        published = 1;
+    }
+
+    Snapshot Holder::Acquire() const
+    {
+        // Both sides are seq_cst: either we see the writer move current away from this slot and retry,
+        // or the writer sees our pin and leaves the slot alone.
+        for (;;) {
+            const int index = current.load();
+            const Slot& slot = slots[index];
+            slot.readers.fetch_add(1);
+            if (current.load() == index) {
+                Snapshot snapshot;
+                snapshot.readers = &slot.readers;
+                snapshot.data = &slot.config;
+                snapshot.version = slot.version;
+                return snapshot;
+            }
+            slot.readers.fetch_sub(1);
+        }
+    }
+
+    bool Holder::Publish(const Config& edited, unsigned int generation)
+    {
+        if (generation == publishedGeneration) return true;
+
+        const int active = current.load();
+        for (int i = 1; i < kSlotCount; i++) {
+            const int index = (active + i) % kSlotCount;
+            Slot& slot = slots[index];
+            if (slot.readers.load() != 0) continue;
+
+            // Readers that race in now back off in Acquire() until current points here
+            slot.config = edited;
+            slot.version = ++published;
+            current.store(index);
+            publishedGeneration = generation;
+            return true;
+        }
+        skipped++;
+        return false;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "menu.h"
+
+// Read-copy-update holder for Config. The UI thread keeps editing *config in place and publishes
+// a copy at the end of the frame (only if the config generation moved); any other thread reads
+// the last published copy through Acquire() and never sees a half-applied edit.
+//
+// The copies live in a few fixed slots with a reader count each, so neither side allocates or
+// locks. A reader pins the current slot (one increment, one load to confirm it is still current);
+// the writer only reuses a slot that is neither current nor pinned. If every spare slot is pinned
+// the publish is skipped and retried the next frame, so edits coalesce instead of blocking.
+namespace configsnapshot
+{
+    inline constexpr int kSlotCount = 4;
+
+    struct Holder;
+
+    // Pinned, immutable view of one published config. Keep it short-lived: a pinned slot can't be reused.
+    class Snapshot {
+    public:
+        Snapshot() = default;
+        Snapshot(Snapshot&& other) noexcept;
+        Snapshot& operator=(Snapshot&& other) noexcept;
+        ~Snapshot();
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        const Config& operator*() const { return *data; }
+        const Config* operator->() const { return data; }
+        explicit operator bool() const { return data != nullptr; }
+
+        // Number of the publish this snapshot came from (1 = the initial config)
+        uint64_t Version() const { return version; }
+
+    private:
+        friend struct Holder;
+        std::atomic<int>* readers = nullptr;
+        const Config* data = nullptr;
+        uint64_t version = 0;
+
+        void Release();
+    };
+
+    struct Holder {
+        explicit Holder(const Config& initial = Config());
+        Holder(const Holder&) = delete;
+        Holder& operator=(const Holder&) = delete;
+
+        // Any thread
+        Snapshot Acquire() const;
+
+        // UI thread only, at the end of the frame. Copies edited into a free slot and makes it current
+        // unless generation was already published. Returns false if it had to skip (every spare slot pinned).
+        bool Publish(const Config& edited, unsigned int generation);
+
+        // Statistics (UI thread)
+        uint64_t published = 0;
+        uint64_t skipped = 0;
+
+    private:
+        struct Slot {
+            Config config;
+            uint64_t version = 0;
+            mutable std::atomic<int> readers{ 0 };
+        };
+
+        Slot slots[kSlotCount];
+        std::atomic<int> current{ 0 };
+        unsigned int publishedGeneration = 0;
+    };
+}
+
+// Published config for threads other than the render thread, updated at the end of every frame
+inline configsnapshot::Holder* configSnapshots = new configsnapshot::Holder(*config);
@@ -1,18 +1,20 @@
 #include "menu.h"
+#include "../crosshair.h"
+#include "../textcache.h"
+#include "configcatalog.h"
+#include "configfile.h"
+#include "configio.h"
+#include <algorithm>
 #include <random>
 #include <imgui_internal.h>
 #include <string>
-#include <fstream>
-#include <filesystem>
+#include <utility>
 #include <chrono>
 #include <atomic>
 
 namespace menu {
     static std::random_device rd;
     static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> xDist(0.0f, 1.0f);
-    static std::uniform_real_distribution<float> speedDist(0.1f, 0.35f);
-    static std::uniform_real_distribution<float> sizeDist(1.0f, 4.0f);
 
     // Accent colors
     static const ImVec4 accentPurple = ImVec4(0.41f, 0.25f, 0.78f, 1.00f);
@@ -29,11 +31,14 @@ namespace menu {
 
     // clamp CPS to allowed range
     static void ClampAutoclickerRange() {
+        const int oldMin = config->autoclicker.minCps;
+        const int oldMax = config->autoclicker.maxCps;
         if (config->autoclicker.minCps < 1) config->autoclicker.minCps = 1;
         if (config->autoclicker.maxCps < 1) config->autoclicker.maxCps = 1;
         if (config->autoclicker.minCps > 30) config->autoclicker.minCps = 30;
         if (config->autoclicker.maxCps > 30) config->autoclicker.maxCps = 30;
         if (config->autoclicker.maxCps < config->autoclicker.minCps) config->autoclicker.maxCps = config->autoclicker.minCps;
+        if (config->autoclicker.minCps != oldMin || config->autoclicker.maxCps != oldMax) MarkConfigDirty(ConfigSection::Autoclicker);
     }
 
     // Generate next interval (seconds) based on min/max CPS with humanization
@@ -65,21 +70,16 @@ namespace menu {
     }
 
     static void PerformClickEvent() {
-        INPUT inputs[2] = {};
-        inputs[0].type = INPUT_MOUSE;
-        inputs[0].mi.dwFlags = MOUSEEVENTF_LEFTDOWN;
-        inputs[1].type = INPUT_MOUSE;
-        inputs[1].mi.dwFlags = MOUSEEVENTF_LEFTUP;
-        SendInput(2, inputs, sizeof(INPUT));
+        platform::SendLeftClick();
     }
 
-    static void UpdateAutoClicker() {
+    void UpdateAutoClicker() {
         if (!config->autoclicker.enabled) return;
         // if key is 0, disabled
         if (config->autoclicker.key == 0) return;
 
         // handle toggle mode key press (edge detect)
-        bool keyDown = (GetAsyncKeyState(config->autoclicker.key) & 0x8000) != 0;
+        bool keyDown = platform::IsKeyDown(config->autoclicker.key);
         static bool prevKeyState = false;
         if (config->autoclicker.mode == 1) { // toggle
             if (keyDown && !prevKeyState) {
@@ -113,64 +113,131 @@ namespace menu {
         }
     }
 
-    static bool EnsureConfigsDir() {
-        std::error_code ec;
-        std::filesystem::create_directories(kConfigsDir, ec);
-        return !ec;
+    // Index of configs/, rescanned only after our own save/delete or a change in the directory
+    static configcatalog::Catalog g_configCatalog(kConfigsDir);
+
+    // Config file I/O runs on this worker, PollConfigIO() applies the results on the render thread
+    static configio::Worker g_configIO(kConfigsDir);
+
+    // Result of the last save/load, shown under the config list
+    static std::string g_configStatus;
+
+    // Config last loaded or saved. Its file is watched through the catalog: when it changes on disk
+    // it is reloaded and only the fields the file changed are applied.
+    static configio::ActiveFile g_activeConfig;
+
+    // Marks every section with a changed field, so caches of untouched sections stay valid
+    static void MarkSectionsDirty(const configfile::Diff& diff) {
+        for (int section = 0; section < static_cast<int>(ConfigSection::Count); section++)
+            if (diff.Has(static_cast<ConfigSection>(section))) MarkConfigDirty(static_cast<ConfigSection>(section));
+    }
+
+    static std::string DescribeSections(const configfile::Diff& diff) {
+        std::string out;
+        for (int section = 0; section < static_cast<int>(ConfigSection::Count); section++) {
+            if (!diff.Has(static_cast<ConfigSection>(section))) continue;
+            if (!out.empty()) out += ", ";
+            out += kConfigSectionNames[section];
+        }
+        return out.empty() ? "no changes" : out;
+    }
+
+    // Queues a reload when the active config's file changed since we last read or wrote it
+    static void WatchActiveConfig() {
+        const auto& list = g_configCatalog.Entries();
+        if (g_activeConfig.name.empty()) return;
+        const int index = g_configCatalog.Find(g_activeConfig.name);
+        if (g_activeConfig.Changed(index < 0 ? nullptr : &list[index]))
+            g_configIO.Reload(g_activeConfig.name);
     }
 
     static bool SaveConfigToFile(const std::string& name) {
         if (name.empty()) return false;
-        if (!EnsureConfigsDir()) return false;
-        std::string path = kConfigsDir + "/" + name + ".cfg";
-        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
-        if (!ofs) return false;
-        ofs.write(reinterpret_cast<const char*>(config), sizeof(*config));
-        return ofs.good();
+        g_configIO.Save(name, *config);
+        g_activeConfig.Saving();
+        g_configStatus = "Saving " + name + "...";
+        return true;
     }
 
     static bool LoadConfigFromFile(const std::string& name) {
         if (name.empty()) return false;
-        std::string path = kConfigsDir + "/" + name + ".cfg";
-        std::ifstream ifs(path, std::ios::binary);
-        if (!ifs) return false;
-        Config tmp;
-        ifs.read(reinterpret_cast<char*>(&tmp), sizeof(tmp));
-        if (!ifs) return false;
-        *config = tmp;
+        g_configIO.Load(name);
+        g_configStatus = "Loading " + name + "...";
+        return true;
+    }
+
+    static bool DeleteConfigFile(const std::string& name) {
+        if (name.empty()) return false;
+        g_configIO.Delete(name);
         return true;
     }
 
-    static std::vector<std::string> ListConfigs() {
-        std::vector<std::string> out;
-        std::error_code ec;
-        if (!std::filesystem::exists(kConfigsDir, ec)) return out;
-        for (auto it = std::filesystem::directory_iterator(kConfigsDir, ec); it != std::filesystem::directory_iterator(); ++it) {
-            if (ec) break;
-            const auto& ent = *it;
-            if (!ent.is_regular_file()) continue;
-            auto p = ent.path();
-            if (p.extension() == ".cfg") {
-                out.push_back(p.stem().string());
+    void PollConfigIO() {
+        configio::Completion done;
+        while (g_configIO.Poll(done)) {
+            switch (done.op) {
+            case configio::Op::Save:
+                g_configStatus = (done.ok ? "Saved " : "Failed to save ") + done.name;
+                g_configCatalog.Invalidate();
+                g_activeConfig.Saved(done);
+                break;
+            case configio::Op::Load:
+                g_configStatus = (done.ok ? "Loaded " : "Failed to load ") + done.name + " (" + configfile::StatusName(done.load.status) + ")";
+                if (done.ok) {
+                    const configfile::Diff diff = configfile::Compare(*config, *done.config);
+                    g_activeConfig.Loaded(done);
+                    // Fully parsed off-thread, so the switch is a single pointer store between two frames
+                    delete std::exchange(config, done.config.release());
+                    MarkSectionsDirty(diff);
+                }
+                break;
+            case configio::Op::Reload:
+                // A reload of a file that is no longer the active config (switched meanwhile) is dropped
+                if (done.name != g_activeConfig.name) break;
+                if (done.ok) {
+                    // Only what changed in the file since we last read or wrote it, unsaved edits stay
+                    const configfile::Diff diff = g_activeConfig.Reloaded(done, *config);
+                    MarkSectionsDirty(diff);
+                    g_configStatus = "Reloaded " + done.name + " (" + DescribeSections(diff) + ")";
+                } else {
+                    // Most likely caught mid-write, the final write triggers another reload
+                    g_configStatus = "Failed to reload " + done.name + " (" + configfile::StatusName(done.load.status) + ")";
+                }
+                break;
+            case configio::Op::ExportJson:
+                g_configStatus = (done.ok ? "Exported " : "Failed to export ") + done.name + ".json";
+                break;
+            case configio::Op::ImportJson:
+                if (done.ok) {
+                    const configfile::Diff diff = configfile::Compare(*config, *done.config);
+                    delete std::exchange(config, done.config.release());
+                    MarkSectionsDirty(diff);
+                    g_configStatus = "Imported " + done.name + ".json (" + DescribeSections(diff) + ")";
+                } else {
+                    g_configStatus = "Failed to import " + done.name + ".json (" + done.error + ")";
+                }
+                break;
+            case configio::Op::Delete:
+                if (!done.ok) g_configStatus = "Failed to delete " + done.name;
+                g_configCatalog.Invalidate();
+                break;
+            case configio::Op::Recover:
+                if (done.recovered) g_configCatalog.Invalidate();
+                break;
             }
         }
-        std::sort(out.begin(), out.end());
-        return out;
+        WatchActiveConfig();
     }
 
-    static bool DeleteConfigFile(const std::string& name) {
-        std::string path = kConfigsDir + "/" + name + ".cfg";
-        std::error_code ec;
-        return std::filesystem::remove(path, ec);
+    void ShutdownConfigIO() {
+        g_configIO.Stop();
     }
 
     // Helper: get readable key name for virtual-key code
     static std::string GetKeyName(int vk) {
         if (vk == 0) return std::string("None");
-        UINT scan = MapVirtualKeyA(vk, MAPVK_VK_TO_VSC);
-        LONG lParam = (scan << 16);
-        char name[64] = {0};
-        if (GetKeyNameTextA(lParam, name, (int)sizeof(name))) return std::string(name);
+        std::string name = platform::KeyName(vk);
+        if (!name.empty()) return name;
         switch (vk) {
             case VK_INSERT: return "INSERT";
             case VK_DELETE: return "DELETE";
@@ -208,6 +275,12 @@ namespace menu {
         style.PopupRounding = 8.0f;
         style.Alpha = 1.0f;
 
+        // Particle sprite lives in the font atlas, bake it before the backend uploads the texture
+        ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+        particles::RegisterSprite(fonts);
+        fonts->Build();
+        particles::BakeSprite(fonts);
+
         ImVec4* colors = style.Colors;
         colors[ImGuiCol_Text] = ImVec4(0.86f, 0.86f, 0.88f, 1.00f);
         colors[ImGuiCol_TextDisabled] = ImVec4(0.40f, 0.40f, 0.43f, 1.00f);
@@ -279,49 +352,19 @@ namespace menu {
     // Continuous menu particles that loop from top to bottom and stay anchored to the menu content
     void UpdateMenuParticles(const ImVec2& areaSize) {
         if (!config->particles.enabled) return;
-        const float deltaTime = ImGui::GetIO().DeltaTime;
-
-        size_t target = static_cast<size_t>(config->particles.particleCount);
-        while (globals->particles.size() < target) {
-            Particle p;
-            p.Position = ImVec2(xDist(gen) * areaSize.x, - (5.0f + xDist(gen) * 40.0f));
-            // vertical speed larger for bigger/smoother fall
-            float vy = 30.0f + speedDist(gen) * 120.0f * (config->particles.particleSpeed);
-            p.Velocity = ImVec2((xDist(gen) - 0.5f) * 8.0f, vy);
-            p.Size = sizeDist(gen) * (config->particles.particleSize * 0.9f);
-            p.Alpha = 0.55f + xDist(gen) * 0.45f;
-            globals->particles.push_back(p);
-        }
-
-        for (auto& p : globals->particles) {
-            p.Position.x += p.Velocity.x * deltaTime;
-            p.Position.y += p.Velocity.y * deltaTime;
-
-            // horizontal wrap-around
-            if (p.Position.x < -40.0f) p.Position.x = areaSize.x + 40.0f;
-            if (p.Position.x > areaSize.x + 40.0f) p.Position.x = -40.0f;
-
-            // loop vertically: when below, reset to above with random x
-            if (p.Position.y > areaSize.y + 20.0f) {
-                p.Position.y = - (5.0f + xDist(gen) * 40.0f);
-                p.Position.x = xDist(gen) * areaSize.x;
-            }
-        }
+        particles::SpawnParams spawn;
+        spawn.speed = config->particles.particleSpeed;
+        spawn.size = config->particles.particleSize;
+        // Loaded configs are sanitized, but a NaN or negative count must never reach the size_t conversion
+        const float count = config->particles.particleCount;
+        const size_t target = count > 0.0f ? static_cast<size_t>(std::min(count, particles::kMaxCount)) : 0;
+        particles::Spawn(globals->particles, target, areaSize, spawn);
+        particles::Integrate(globals->particles, ImGui::GetIO().DeltaTime, areaSize);
     }
 
     void DrawMenuParticles(const ImVec2& areaPos, const ImVec2& areaSize) {
         if (!config->particles.enabled) return;
-        ImDrawList* draw_list = ImGui::GetWindowDrawList();
-
-        for (const auto& p : globals->particles) {
-            // Only draw within area bounds (with margin)
-            if (p.Position.x < -40.0f || p.Position.x > areaSize.x + 40.0f) continue;
-            if (p.Position.y < -60.0f || p.Position.y > areaSize.y + 60.0f) continue;
-
-            ImVec2 pos = ImVec2(areaPos.x + p.Position.x, areaPos.y + p.Position.y);
-            const ImU32 col = IM_COL32(220, 230, 255, static_cast<int>(220 * p.Alpha));
-            draw_list->AddCircleFilled(pos, p.Size * 0.6f, col);
-        }
+        particles::Draw(ImGui::GetWindowDrawList(), globals->particles, areaPos, areaSize);
     }
 
     void DrawWatermark() {
@@ -329,16 +372,16 @@ namespace menu {
         ImDrawList* draw_list = ImGui::GetBackgroundDrawList();
         ImGuiIO& io = ImGui::GetIO();
 
-        const char* text = "OniV2 | FPS: %.0f";
-        char buffer[256];
-        snprintf(buffer, sizeof(buffer), text, io.Framerate);
+        // Only the FPS digits that changed since last frame are re-laid out
+        static textcache::NumberLabel label;
+        textcache::SetNumber(label, ImGui::GetFont(), ImGui::GetFontSize(), "OniV2 | FPS: ", static_cast<int>(io.Framerate + 0.5f));
 
-        ImVec2 textSize = ImGui::CalcTextSize(buffer);
+        ImVec2 textSize = label.Out.Size;
         ImVec2 pos = ImVec2(io.DisplaySize.x - textSize.x - 20, 10);
 
         draw_list->AddRectFilled(ImVec2(pos.x - 10, pos.y - 5), ImVec2(pos.x + textSize.x + 10, pos.y + textSize.y + 5), IM_COL32(0,0,0,160), 8.0f);
         draw_list->AddRect(ImVec2(pos.x - 10, pos.y - 5), ImVec2(pos.x + textSize.x + 10, pos.y + textSize.y + 5), IM_COL32(255,255,255,30), 8.0f);
-        draw_list->AddText(pos, IM_COL32(255,255,255,255), buffer);
+        textcache::Blit(draw_list, label.Out, pos, IM_COL32(255,255,255,255));
     }
 
     void Draw() {
@@ -415,18 +458,17 @@ namespace menu {
             ImGui::Separator();
             ImGui::Spacing();
 
-            ImGui::Checkbox("Enable Crosshair", &config->crosshair.enabled);
+            if (ImGui::Checkbox("Enable Crosshair", &config->crosshair.enabled)) MarkConfigDirty(ConfigSection::Crosshair);
             if (config->crosshair.enabled) {
-                ImGui::SliderInt("Size", &config->crosshair.size, 1, 50);
-                ImGui::SliderInt("Thickness", &config->crosshair.thickness, 1, 10);
-                ImGui::ColorEdit4("Color", config->crosshair.color, ImGuiColorEditFlags_AlphaBar);
+                if (ImGui::SliderInt("Size", &config->crosshair.size, 1, 50)) MarkConfigDirty(ConfigSection::Crosshair);
+                if (ImGui::SliderInt("Thickness", &config->crosshair.thickness, 1, 10)) MarkConfigDirty(ConfigSection::Crosshair);
+                if (ImGui::ColorEdit4("Color", config->crosshair.color, ImGuiColorEditFlags_AlphaBar)) MarkConfigDirty(ConfigSection::Crosshair);
 
-                const char* types[] = { "Cross", "Dot", "Plus", "Triangle", "Circle", "Windmill1954", "Pinwheel" };
-                ImGui::Combo("Type", &config->crosshair.type, types, IM_ARRAYSIZE(types));
+                if (ImGui::Combo("Type", &config->crosshair.type, crosshair::kShapeNames, IM_ARRAYSIZE(crosshair::kShapeNames))) MarkConfigDirty(ConfigSection::Crosshair);
 
-                ImGui::Checkbox("Rainbow Effect", &config->crosshair.rainbow);
-                ImGui::Checkbox("Rotating", &config->crosshair.rotating);
-                if (config->crosshair.rotating) ImGui::SliderFloat("Rotation Speed", &config->crosshair.rotationSpeed, 0.1f, 5.0f, "%.1f");
+                if (ImGui::Checkbox("Rainbow Effect", &config->crosshair.rainbow)) MarkConfigDirty(ConfigSection::Crosshair);
+                if (ImGui::Checkbox("Rotating", &config->crosshair.rotating)) MarkConfigDirty(ConfigSection::Crosshair);
+                if (config->crosshair.rotating && ImGui::SliderFloat("Rotation Speed", &config->crosshair.rotationSpeed, 0.1f, 5.0f, "%.1f")) MarkConfigDirty(ConfigSection::Crosshair);
             }
 
         } else if (selectedIndex == 1) { // Autoclicker
@@ -434,15 +476,15 @@ namespace menu {
             ImGui::Separator();
             ImGui::Spacing();
 
-            ImGui::Checkbox("Enable Autoclicker", &config->autoclicker.enabled);
+            if (ImGui::Checkbox("Enable Autoclicker", &config->autoclicker.enabled)) MarkConfigDirty(ConfigSection::Autoclicker);
             ImGui::Text("Key:"); ImGui::SameLine(); ImGui::Text("%d", config->autoclicker.key);
-            ImGui::SliderInt("Minimum CPS", &config->autoclicker.minCps, 1, 200);
-            ImGui::SliderInt("Maximum CPS", &config->autoclicker.maxCps, 1, 200);
+            if (ImGui::SliderInt("Minimum CPS", &config->autoclicker.minCps, 1, 200)) MarkConfigDirty(ConfigSection::Autoclicker);
+            if (ImGui::SliderInt("Maximum CPS", &config->autoclicker.maxCps, 1, 200)) MarkConfigDirty(ConfigSection::Autoclicker);
 
             // Autoclicker mode: toggle or hold
             const char* modes[] = { "Hold", "Toggle" };
-            ImGui::Combo("Mode", &config->autoclicker.mode, modes, IM_ARRAYSIZE(modes));
-            ImGui::Checkbox("Humanize", &config->autoclicker.humanize);
+            if (ImGui::Combo("Mode", &config->autoclicker.mode, modes, IM_ARRAYSIZE(modes))) MarkConfigDirty(ConfigSection::Autoclicker);
+            if (ImGui::Checkbox("Humanize", &config->autoclicker.humanize)) MarkConfigDirty(ConfigSection::Autoclicker);
             ImGui::Text("Current interval: %.4f ms", GenerateNextIntervalSec() * 1000.0f);
 
         } else if (selectedIndex == 2) { // Configs
@@ -455,41 +497,59 @@ namespace menu {
             ImGui::InputText("Name", cfgName, sizeof(cfgName));
             ImGui::SameLine();
             if (ImGui::Button("Save")) {
-                bool ok = SaveConfigToFile(cfgName);
-                (void)ok; // could show feedback
+                SaveConfigToFile(cfgName);
             }
             ImGui::SameLine();
             if (ImGui::Button("Save As Default")) {
                 SaveConfigToFile("default");
             }
+            // Human-readable copy in configs/<name>.json
+            if (ImGui::Button("Export JSON") && cfgName[0]) {
+                g_configIO.ExportJson(cfgName, *config);
+                g_configStatus = std::string("Exporting ") + cfgName + ".json...";
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Import JSON") && cfgName[0]) {
+                g_configIO.ImportJson(cfgName);
+                g_configStatus = std::string("Importing ") + cfgName + ".json...";
+            }
 
             ImGui::Spacing();
             ImGui::Text("Available configs:");
             ImGui::BeginChild("ConfigsList", ImVec2(0, 160), true);
-            static int sel = -1;
-            auto list = ListConfigs();
-            for (int i = 0; i < (int)list.size(); ++i) {
-                bool active = (sel == i);
-                if (ImGui::Selectable(list[i].c_str(), active)) sel = i;
+            // Selection by name, so it survives rescans that add or remove other entries
+            static std::string selName;
+            const auto& list = g_configCatalog.Entries();
+            for (const auto& entry : list) {
+                bool active = (selName == entry.name);
+                if (ImGui::Selectable(entry.name.c_str(), active)) selName = entry.name;
+                if (ImGui::IsItemHovered()) {
+                    if (entry.version) ImGui::SetTooltip("%llu bytes, format v%u", (unsigned long long)entry.size, (unsigned)entry.version);
+                    else ImGui::SetTooltip("%llu bytes, legacy format", (unsigned long long)entry.size);
+                }
             }
             ImGui::EndChild();
 
+            const bool hasSelection = g_configCatalog.Find(selName) >= 0;
             ImGui::Spacing();
-            if (ImGui::Button("Load Selected") && sel >= 0 && sel < (int)list.size()) {
-                LoadConfigFromFile(list[sel]);
+            if (ImGui::Button("Load Selected") && hasSelection) {
+                LoadConfigFromFile(selName);
             }
             ImGui::SameLine();
-            if (ImGui::Button("Delete Selected") && sel >= 0 && sel < (int)list.size()) {
-                DeleteConfigFile(list[sel]);
-                sel = -1;
+            if (ImGui::Button("Delete Selected") && hasSelection) {
+                DeleteConfigFile(selName);
+                selName.clear();
             }
+            if (!g_configStatus.empty()) ImGui::TextColored(THEME_TEXT_DIM, "%s", g_configStatus.c_str());
 
         } else if (selectedIndex == 3) { // Settings
              ImGui::Text("Settings");
              ImGui::Separator();
              ImGui::Spacing();
-             ImGui::Checkbox("VSync", &config->menu.vsync);
-             ImGui::Checkbox("Stream Proof", &config->menu.streamproof);
+             if (ImGui::Checkbox("VSync", &config->menu.vsync)) MarkConfigDirty(ConfigSection::Menu);
+             if (ImGui::Checkbox("Stream Proof", &config->menu.streamproof)) MarkConfigDirty(ConfigSection::Menu);
+             ImGui::Checkbox("Show Profiler", &globals->showProfiler);
+             ImGui::Checkbox("Merge Draw Calls", &globals->mergeDrawCalls);
 
 
          } else {
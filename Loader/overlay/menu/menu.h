@@ -1,9 +1,11 @@
 #pragma once
 #include <imgui.h>
 #include <vector>
-#include <Windows.h>
 #include <atomic>
 
+#include "particles.h"
+#include "../platform.h"
+
 // UI Theme Colors
 #define THEME_BACKGROUND     ImVec4(0.07f, 0.07f, 0.09f, 1.00f)
 #define THEME_ACCENT        ImVec4(0.28f, 0.56f, 1.00f, 1.00f)
@@ -11,15 +13,6 @@
 #define THEME_TEXT          ImVec4(0.86f, 0.86f, 0.86f, 1.00f)
 #define THEME_TEXT_DIM      ImVec4(0.60f, 0.60f, 0.60f, 1.00f)
 
-// Particle System
-struct Particle {
-    ImVec2 Position = ImVec2(0.0f, 0.0f);
-    ImVec2 Velocity = ImVec2(0.0f, 0.0f);
-    float Size = 0.0f;
-    float Alpha = 0.0f;
-    float Life = 0.0f;
-};
-
 // Configuration structure
 struct Config {
     struct {
@@ -38,7 +31,7 @@ struct Config {
         bool rotating = false;
         bool rainbow = false;
         float rotationSpeed = 1.0f;
-        int type = 0; // 0=Cross, 1=Dot, 2=Plus, 3=Triangle, 4=Circle, 5=Windmill1954, 6=Pinwheel
+        int type = 0; // crosshair::Shape: 0=Cross, 1=Dot, 2=Plus, 3=Triangle, 4=Circle, 5=Windmill1954, 6=Pinwheel
     } crosshair;
 
     // Aimbot configuration (added to support menu controls)
@@ -71,12 +64,36 @@ struct Config {
 struct Globals {
     bool running = false;
     bool menuOpen = false;
-    std::vector<Particle> particles;
+    bool showProfiler = false;
+    bool mergeDrawCalls = true;     // drawmerge pass between ImGui::Render() and the backend
+    particles::ParticleStore particles;
 };
 
 inline Config* config = new Config();
 inline Globals* globals = new Globals();
 
+// Top-level parts of Config, in member order
+enum class ConfigSection : int {
+    Menu = 0,
+    Crosshair,
+    Aimbot,
+    Autoclicker,
+    Particles,
+    Count
+};
+
+// Member names, also the section keys of the JSON export
+inline constexpr const char* kConfigSectionNames[] = { "menu", "crosshair", "aimbot", "autoclicker", "particles" };
+static_assert(sizeof(kConfigSectionNames) / sizeof(kConfigSectionNames[0]) == static_cast<size_t>(ConfigSection::Count), "every config section needs a name");
+
+// Generation of *config. Anything that edits the config bumps it via MarkConfigDirty(),
+// consumers (overlay sync, crosshair cache) only re-derive their state when it moved.
+// Each section has its own generation too, so e.g. a particle edit doesn't re-sync the crosshair.
+inline unsigned int g_configGeneration = 1;
+inline unsigned int g_configSectionGeneration[static_cast<int>(ConfigSection::Count)] = { 1, 1, 1, 1, 1 };
+inline void MarkConfigDirty(ConfigSection section) { ++g_configGeneration; ++g_configSectionGeneration[static_cast<int>(section)]; }
+inline void MarkConfigDirty() { ++g_configGeneration; for (unsigned int& generation : g_configSectionGeneration) ++generation; }
+
 // Flag used when capturing a new menu key in the settings UI
 inline std::atomic<bool> g_capturingMenuKey{ false };
 
@@ -93,6 +110,12 @@ namespace menu {
     void UpdateParticles();
     void DrawParticles();
     void UpdateAutoClicker();
+
+    // Applies finished config saves/loads from the I/O worker and reloads the active config when its
+    // file changed on disk, once per frame on the render thread
+    void PollConfigIO();
+    // Writes out any queued saves and stops the worker
+    void ShutdownConfigIO();
 }
 
 namespace drawlist {
@@ -0,0 +1,265 @@
+#include "particles.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PARTICLES_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLES_SSE2
+#endif
+
+namespace particles
+{
+    static Rng rng((static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}());
+
+    // Area margins: particles wrap 40px outside the sides and respawn 20px below the bottom
+    static constexpr float kWrapMargin = 40.0f;
+    static constexpr float kBottomMargin = 20.0f;
+
+    // Soft dot sprite: 32x32 texels, dot radius 15 with a one texel falloff
+    static constexpr int kSpriteSize = 32;
+    static constexpr float kSpriteRadius = 15.0f;
+    static int g_spriteRectId = -1;
+    static bool g_spriteBaked = false;
+    static const ImFontAtlas* g_spriteAtlas = nullptr;
+    static ImVec2 g_spriteUv0, g_spriteUv1;
+
+    Rng::Rng(uint64_t seed)
+    {
+        // splitmix64 to spread the seed over the whole state (which must not be all zero)
+        for (int i = 0; i < 2; i++) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            s[i * 2] = static_cast<uint32_t>(z);
+            s[i * 2 + 1] = static_cast<uint32_t>(z >> 32);
+        }
+    }
+
+    uint32_t Rng::Next()
+    {
+        const uint32_t result = s[0] + s[3];
+        const uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = (s[3] << 11) | (s[3] >> 21);
+        return result;
+    }
+
+    void SeedRng(uint64_t seed)
+    {
+        rng = Rng(seed);
+    }
+
+    void ParticleStore::Reserve(size_t n)
+    {
+        if (n <= Capacity()) return;
+        n = std::max(n, Capacity() + Capacity() / 2);
+        x.resize(n); y.resize(n);
+        vx.resize(n); vy.resize(n);
+        size.resize(n);
+        alpha.resize(n);
+    }
+
+    void Spawn(ParticleStore& store, size_t target, const ImVec2& areaSize, const SpawnParams& params)
+    {
+        if (target <= store.count) {
+            store.count = target;
+            return;
+        }
+
+        store.Reserve(target);
+        for (size_t i = store.count; i < target; i++) {
+            store.x[i] = rng.NextFloat() * areaSize.x;
+            store.y[i] = -(5.0f + rng.NextFloat() * 40.0f);
+            // vertical speed larger for bigger/smoother fall
+            store.vy[i] = 30.0f + (0.1f + rng.NextFloat() * 0.25f) * 120.0f * params.speed;
+            store.vx[i] = (rng.NextFloat() - 0.5f) * 8.0f;
+            store.size[i] = (1.0f + rng.NextFloat() * 3.0f) * (params.size * 0.9f);
+            store.alpha[i] = 0.55f + rng.NextFloat() * 0.45f;
+        }
+        store.count = target;
+    }
+
+    // Loop vertically: back above the area with a random x
+    static inline void Respawn(ParticleStore& store, size_t i, const ImVec2& areaSize)
+    {
+        store.y[i] = -(5.0f + rng.NextFloat() * 40.0f);
+        store.x[i] = rng.NextFloat() * areaSize.x;
+    }
+
+    static inline void IntegrateOne(ParticleStore& store, size_t i, float deltaTime, const ImVec2& areaSize)
+    {
+        float px = store.x[i] + store.vx[i] * deltaTime;
+        float py = store.y[i] + store.vy[i] * deltaTime;
+
+        // horizontal wrap-around
+        if (px < -kWrapMargin) px = areaSize.x + kWrapMargin;
+        else if (px > areaSize.x + kWrapMargin) px = -kWrapMargin;
+
+        store.x[i] = px;
+        store.y[i] = py;
+        if (py > areaSize.y + kBottomMargin)
+            Respawn(store, i, areaSize);
+    }
+
+    void IntegrateScalar(ParticleStore& store, float deltaTime, const ImVec2& areaSize)
+    {
+        const size_t count = store.Count();
+        for (size_t i = 0; i < count; i++)
+            IntegrateOne(store, i, deltaTime, areaSize);
+    }
+
+    void Integrate(ParticleStore& store, float deltaTime, const ImVec2& areaSize)
+    {
+        const size_t count = store.Count();
+        float* xs = store.x.data();
+        float* ys = store.y.data();
+        const float* vxs = store.vx.data();
+        const float* vys = store.vy.data();
+        size_t i = 0;
+
+#if defined(PARTICLES_AVX2)
+        const __m256 dt = _mm256_set1_ps(deltaTime);
+        const __m256 left = _mm256_set1_ps(-kWrapMargin);
+        const __m256 right = _mm256_set1_ps(areaSize.x + kWrapMargin);
+        const __m256 bottom = _mm256_set1_ps(areaSize.y + kBottomMargin);
+        for (; i + 8 <= count; i += 8) {
+            __m256 px = _mm256_add_ps(_mm256_loadu_ps(xs + i), _mm256_mul_ps(_mm256_loadu_ps(vxs + i), dt));
+            __m256 py = _mm256_add_ps(_mm256_loadu_ps(ys + i), _mm256_mul_ps(_mm256_loadu_ps(vys + i), dt));
+            const __m256 pastLeft = _mm256_cmp_ps(px, left, _CMP_LT_OQ);
+            const __m256 pastRight = _mm256_cmp_ps(px, right, _CMP_GT_OQ);
+            px = _mm256_blendv_ps(px, right, pastLeft);
+            px = _mm256_blendv_ps(px, left, pastRight);
+            _mm256_storeu_ps(xs + i, px);
+            _mm256_storeu_ps(ys + i, py);
+
+            int below = _mm256_movemask_ps(_mm256_cmp_ps(py, bottom, _CMP_GT_OQ));
+            for (int lane = 0; below; lane++, below >>= 1)
+                if (below & 1) Respawn(store, i + lane, areaSize);
+        }
+#elif defined(PARTICLES_SSE2)
+        const __m128 dt = _mm_set1_ps(deltaTime);
+        const __m128 left = _mm_set1_ps(-kWrapMargin);
+        const __m128 right = _mm_set1_ps(areaSize.x + kWrapMargin);
+        const __m128 bottom = _mm_set1_ps(areaSize.y + kBottomMargin);
+        for (; i + 4 <= count; i += 4) {
+            __m128 px = _mm_add_ps(_mm_loadu_ps(xs + i), _mm_mul_ps(_mm_loadu_ps(vxs + i), dt));
+            __m128 py = _mm_add_ps(_mm_loadu_ps(ys + i), _mm_mul_ps(_mm_loadu_ps(vys + i), dt));
+            const __m128 pastLeft = _mm_cmplt_ps(px, left);
+            const __m128 pastRight = _mm_cmpgt_ps(px, right);
+            px = _mm_or_ps(_mm_and_ps(pastLeft, right), _mm_andnot_ps(pastLeft, px));
+            px = _mm_or_ps(_mm_and_ps(pastRight, left), _mm_andnot_ps(pastRight, px));
+            _mm_storeu_ps(xs + i, px);
+            _mm_storeu_ps(ys + i, py);
+
+            int below = _mm_movemask_ps(_mm_cmpgt_ps(py, bottom));
+            for (int lane = 0; below; lane++, below >>= 1)
+                if (below & 1) Respawn(store, i + lane, areaSize);
+        }
+#endif
+
+        for (; i < count; i++)
+            IntegrateOne(store, i, deltaTime, areaSize);
+    }
+
+    void RegisterSprite(ImFontAtlas* atlas)
+    {
+        g_spriteBaked = false;
+        g_spriteRectId = atlas->AddCustomRectRegular(kSpriteSize, kSpriteSize);
+    }
+
+    void BakeSprite(ImFontAtlas* atlas)
+    {
+        g_spriteBaked = false;
+        if (g_spriteRectId < 0 || !atlas->IsBuilt() || atlas->TexPixelsAlpha8 == nullptr) return;
+
+        const ImFontAtlasCustomRect* rect = atlas->GetCustomRectByIndex(g_spriteRectId);
+        if (!rect->IsPacked()) return;
+
+        const float center = kSpriteSize * 0.5f;
+        for (int y = 0; y < kSpriteSize; y++) {
+            for (int x = 0; x < kSpriteSize; x++) {
+                const float dx = x + 0.5f - center;
+                const float dy = y + 0.5f - center;
+                const float coverage = std::min(std::max(kSpriteRadius + 0.5f - sqrtf(dx * dx + dy * dy), 0.0f), 1.0f);
+                const unsigned char a = static_cast<unsigned char>(coverage * 255.0f + 0.5f);
+
+                const int offset = (rect->Y + y) * atlas->TexWidth + (rect->X + x);
+                atlas->TexPixelsAlpha8[offset] = a;
+                if (atlas->TexPixelsRGBA32)
+                    atlas->TexPixelsRGBA32[offset] = IM_COL32(255, 255, 255, a);
+            }
+        }
+
+        atlas->CalcCustomRectUV(rect, &g_spriteUv0, &g_spriteUv1);
+        g_spriteAtlas = atlas;
+        g_spriteBaked = true;
+    }
+
+    // False once the atlas was rebuilt behind BakeSprite()'s back: Clear() drops the custom rect, ClearTexData() + Build()
+    // blanks it. The new pixels may reuse the old address (like textcache's AtlasStamp caveat), so this reads the
+    // sprite's centre texel instead of comparing pointers. Pixels freed after the upload leave the texture as baked.
+    static bool SpriteIntact(const ImFontAtlas* atlas)
+    {
+        if (!g_spriteBaked || atlas != g_spriteAtlas || g_spriteRectId >= atlas->CustomRects.Size) return false;
+        const ImFontAtlasCustomRect& rect = atlas->CustomRects[g_spriteRectId];
+        if (!rect.IsPacked() || rect.Width != kSpriteSize || rect.Height != kSpriteSize) return false;
+        if (atlas->TexPixelsAlpha8 == nullptr) return true;
+        return atlas->TexPixelsAlpha8[(rect.Y + kSpriteSize / 2) * atlas->TexWidth + rect.X + kSpriteSize / 2] == 255;
+    }
+
+    static inline bool IsVisible(const ParticleStore& store, size_t i, const ImVec2& areaSize)
+    {
+        // Only draw within area bounds (with margin)
+        if (store.x[i] < -40.0f || store.x[i] > areaSize.x + 40.0f) return false;
+        if (store.y[i] < -60.0f || store.y[i] > areaSize.y + 60.0f) return false;
+        return true;
+    }
+
+    static inline ImU32 ParticleColor(const ParticleStore& store, size_t i)
+    {
+        return IM_COL32(220, 230, 255, static_cast<int>(220 * store.alpha[i]));
+    }
+
+    void Draw(ImDrawList* dl, const ParticleStore& store, const ImVec2& areaPos, const ImVec2& areaSize)
+    {
+        if (!SpriteIntact(ImGui::GetIO().Fonts)) {
+            DrawCircles(dl, store, areaPos, areaSize);
+            return;
+        }
+
+        const int count = static_cast<int>(store.Count());
+        if (count == 0) return;
+
+        // Quad half extent so the dot (not the whole sprite) matches the old circle radius of size * 0.6
+        const float extentScale = 0.6f * (kSpriteSize * 0.5f) / kSpriteRadius;
+
+        dl->PrimReserve(count * 6, count * 4);
+        int drawn = 0;
+        for (int i = 0; i < count; i++) {
+            if (!IsVisible(store, i, areaSize)) continue;
+            const float h = store.size[i] * extentScale;
+            const ImVec2 pos(areaPos.x + store.x[i], areaPos.y + store.y[i]);
+            dl->PrimRectUV(ImVec2(pos.x - h, pos.y - h), ImVec2(pos.x + h, pos.y + h), g_spriteUv0, g_spriteUv1, ParticleColor(store, i));
+            drawn++;
+        }
+        dl->PrimUnreserve((count - drawn) * 6, (count - drawn) * 4);
+    }
+
+    void DrawCircles(ImDrawList* dl, const ParticleStore& store, const ImVec2& areaPos, const ImVec2& areaSize)
+    {
+        for (size_t i = 0; i < store.Count(); i++) {
+            if (!IsVisible(store, i, areaSize)) continue;
+            const ImVec2 pos(areaPos.x + store.x[i], areaPos.y + store.y[i]);
+            dl->AddCircleFilled(pos, store.size[i] * 0.6f, ParticleColor(store, i));
+        }
+    }
+}
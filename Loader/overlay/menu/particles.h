@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <imgui.h>
+
+// Menu background particles, stored as structure-of-arrays so the per-frame
+// integrate-and-wrap step runs 4 (SSE2) or 8 (AVX2) particles at a time. The width is picked at
+// compile time from __AVX2__ (/arch:AVX2, -mavx2); there is no runtime CPU dispatch, so a default
+// x64 build runs the SSE2 loop.
+namespace particles
+{
+    // Most particles the menu spawns; configfile::Sanitize() clamps particleCount to it. At 4 vertices
+    // a particle, Draw()'s single PrimReserve stays well inside a 16-bit index draw list.
+    inline constexpr float kMaxCount = 5000.0f;
+
+    // Fixed-capacity pool: the arrays are only resized by Reserve(), the live
+    // particles are the first Count() entries.
+    struct ParticleStore {
+        std::vector<float> x, y;
+        std::vector<float> vx, vy;
+        std::vector<float> size;
+        std::vector<float> alpha;
+        size_t count = 0;
+
+        size_t Count() const { return count; }
+        size_t Capacity() const { return x.size(); }
+        void Clear() { count = 0; }
+
+        // Grows the pool to hold at least n particles (by at least 1.5x, so dragging the count slider
+        // doesn't reallocate every frame). Never shrinks.
+        void Reserve(size_t n);
+    };
+
+    // xoshiro128+ generator for respawn positions and speeds, a few adds/xors per number
+    struct Rng {
+        uint32_t s[4];
+
+        explicit Rng(uint64_t seed);
+        uint32_t Next();
+        // Uniform in [0, 1)
+        float NextFloat() { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+    };
+
+    struct SpawnParams {
+        float speed = 1.0f;  // config->particles.particleSpeed
+        float size = 2.0f;   // config->particles.particleSize
+    };
+
+    // Reseeds the generator Spawn() and the respawns draw from, so a run can be replayed exactly
+    void SeedRng(uint64_t seed);
+
+    // Adds particles above the area (or drops the last ones) until the store holds target of them.
+    // Only allocates when target exceeds the pool capacity, i.e. when the configured count was raised.
+    void Spawn(ParticleStore& store, size_t target, const ImVec2& areaSize, const SpawnParams& params);
+
+    // Moves every particle by its velocity, wraps horizontally and respawns the ones that fell below the area
+    void Integrate(ParticleStore& store, float deltaTime, const ImVec2& areaSize);
+
+    // Reference scalar version of Integrate(), kept for test_particles and the benchmark
+    void IntegrateScalar(ParticleStore& store, float deltaTime, const ImVec2& areaSize);
+
+    // Soft-dot sprite baked into the font atlas, so every particle is one textured quad.
+    // RegisterSprite() has to run before the atlas is built, BakeSprite() after Build() and before the texture upload.
+    // Code that rebuilds the atlas later has to bake again before re-uploading, or Draw() stays on circles.
+    void RegisterSprite(ImFontAtlas* atlas);
+    void BakeSprite(ImFontAtlas* atlas);
+
+    // Draws every particle inside the area (plus margin) as one quad against the sprite, in a single PrimReserve.
+    // Falls back to DrawCircles() if the sprite isn't in io.Fonts: never baked, or wiped by an atlas rebuild since.
+    void Draw(ImDrawList* dl, const ParticleStore& store, const ImVec2& areaPos, const ImVec2& areaSize);
+
+    // Previous path: one AddCircleFilled per particle
+    void DrawCircles(ImDrawList* dl, const ParticleStore& store, const ImVec2& areaPos, const ImVec2& areaSize);
+}
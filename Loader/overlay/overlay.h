@@ -1,15 +1,24 @@
 #pragma once
+#include <cstdint>
 #include <iostream>
 
+#ifdef _WIN32
 #include <dwmapi.h>
+#endif
 
 #include "menu/menu.h"
+#include "crosshair.h"
+#include "textcache.h"
 
+#ifdef _WIN32
 #include <d3d11.h>
+#endif
 
 #include <imgui.h>
+#ifdef _WIN32
 #include <imgui_impl_dx11.h>
 #include <imgui_impl_win32.h>
+#endif
 #include <imgui_internal.h>
 
 inline ImFont* g_titleFont = nullptr;
@@ -18,6 +27,8 @@ inline ImFont* g_defaultFont = nullptr;
 
 inline ImFont* g_drawFont = nullptr;
 
+// Window and device glue, Windows only. The state and draw_gui() below are platform neutral.
+#ifdef _WIN32
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 namespace window
@@ -41,15 +52,18 @@ namespace window
 	void new_frame();
 	void draw();
 }
+#endif
 
 namespace overlay
 {
+#ifdef _WIN32
 	inline HWND target;
+	bool initialize(HWND window);
+	void click_through(bool click);
+#endif
 	inline uint32_t width, height;
 
-	bool initialize(HWND window);
 	bool scale();
-	void click_through(bool click);
 
 	void draw_gui(); // Declaration added to match implementation
 
@@ -70,12 +84,16 @@ namespace overlay
 	inline int CrosshairSize = 18;        // Radius / half length
 	inline int LineThickness = 3;
 	inline ImU32 CrosshairColor = IM_COL32(255,255,255,255);
-	inline std::string CrosshairShape = "Dot"; // "Dot","Plus","Cross","Triangle","Pinwheel","Windmill1954"
+	inline crosshair::Shape CrosshairShape = crosshair::Shape::Dot;
 
 	inline bool IsRotating = false;
 	inline float RotationAngleDeg = 0.0f; // used when rotating
+	inline float RotationSpeed = 1.0f;
 	inline bool RainbowCrosshair = false;
 
+	// Number of times draw_gui re-derived the settings above from config (once per crosshair section generation)
+	inline unsigned int ConfigSyncCount = 0;
+
 	// Constant for PI
 	inline constexpr double PI_DOUBLE = 3.14159265358979323846;
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "pacing.h"
+#include <cstring>
+
+namespace pacing
+{
+    // Word-at-a-time multiplicative hash, cheap enough to run over the whole frame
+    static inline uint64_t Mix(uint64_t h, uint64_t v)
+    {
+        h ^= v;
+        h *= 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 29);
+    }
+
+    static uint64_t HashBytes(uint64_t h, const void* data, size_t size)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        while (size >= 8)
+        {
+            uint64_t v;
+            memcpy(&v, p, 8);
+            h = Mix(h, v);
+            p += 8;
+            size -= 8;
+        }
+        uint64_t tail = 0;
+        memcpy(&tail, p, size);
+        return Mix(h, tail ^ (static_cast<uint64_t>(size) << 56));
+    }
+
+    static inline uint64_t HashFloat(uint64_t h, float f)
+    {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return Mix(h, bits);
+    }
+
+    uint64_t HashDrawData(const ImDrawData* drawData)
+    {
+        uint64_t h = 0xCBF29CE484222325ull;
+        if (!drawData || !drawData->Valid) return h;
+
+        h = HashFloat(h, drawData->DisplayPos.x);
+        h = HashFloat(h, drawData->DisplayPos.y);
+        h = HashFloat(h, drawData->DisplaySize.x);
+        h = HashFloat(h, drawData->DisplaySize.y);
+        h = Mix(h, static_cast<uint64_t>(drawData->CmdListsCount));
+
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            const ImDrawList* list = drawData->CmdLists[n];
+            h = Mix(h, (static_cast<uint64_t>(list->VtxBuffer.Size) << 32) | static_cast<uint32_t>(list->IdxBuffer.Size));
+            h = HashBytes(h, list->VtxBuffer.Data, list->VtxBuffer.size_in_bytes());
+            h = HashBytes(h, list->IdxBuffer.Data, list->IdxBuffer.size_in_bytes());
+
+            // Field by field, ImDrawCmd has padding
+            for (const ImDrawCmd& cmd : list->CmdBuffer)
+            {
+                h = HashFloat(h, cmd.ClipRect.x);
+                h = HashFloat(h, cmd.ClipRect.y);
+                h = HashFloat(h, cmd.ClipRect.z);
+                h = HashFloat(h, cmd.ClipRect.w);
+                h = Mix(h, reinterpret_cast<uint64_t>(cmd.TextureId));
+                h = Mix(h, (static_cast<uint64_t>(cmd.VtxOffset) << 32) | cmd.IdxOffset);
+                h = Mix(h, cmd.ElemCount);
+                h = Mix(h, reinterpret_cast<uint64_t>(cmd.UserCallback));
+                h = Mix(h, reinterpret_cast<uint64_t>(cmd.UserCallbackData));
+            }
+        }
+        return h;
+    }
+
+    bool FramePacer::ShouldPresent(const ImDrawData* drawData, bool animating, bool force)
+    {
+        if (animating || force || !hasPresented)
+        {
+            // Forget the last hash: the next static frame has to be presented once before we go idle
+            hasPresented = !animating;
+            lastPresentedHash = animating ? 0 : HashDrawData(drawData);
+            unchangedFrames = 0;
+            framesPresented++;
+            return true;
+        }
+
+        const uint64_t hash = HashDrawData(drawData);
+        if (hash == lastPresentedHash)
+        {
+            unchangedFrames++;
+            framesSkipped++;
+            return false;
+        }
+
+        lastPresentedHash = hash;
+        unchangedFrames = 0;
+        framesPresented++;
+        return true;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+
+#include <imgui.h>
+
+// Idle-aware frame pacing: a frame whose draw data is identical to the last presented one
+// is neither rendered nor presented, and the render loop blocks for input instead of spinning.
+// Platform neutral, the Win32 wait lives in load().
+namespace pacing
+{
+    // Hash of everything that ends up on screen: vertex/index buffers, command list and viewport
+    uint64_t HashDrawData(const ImDrawData* drawData);
+
+    struct Policy {
+        int idleAfterFrames = 2;        // unchanged frames in a row before we consider the overlay idle
+        unsigned int idleWaitMs = 20;   // one idle wait slice; the menu key is polled between slices, keep it short
+        unsigned int idleFrameMs = 500; // while idle, a frame is still built this often for background work
+    };
+
+    struct FramePacer {
+        Policy policy;
+
+        uint64_t lastPresentedHash = 0;
+        bool hasPresented = false;
+        int unchangedFrames = 0;
+
+        // Statistics
+        uint64_t framesPresented = 0;
+        uint64_t framesSkipped = 0;
+        uint64_t idleSlices = 0;        // idle waits that ended without input, no frame built
+
+        // Decides whether the frame just built with ImGui::Render() must be drawn and presented.
+        // animating: content changes every frame anyway (menu open, rainbow, rotation), skips hashing.
+        // force: something outside the draw data changed (resize, device reset).
+        bool ShouldPresent(const ImDrawData* drawData, bool animating, bool force);
+
+        bool IsIdle() const { return unchangedFrames >= policy.idleAfterFrames; }
+
+        // Blocks while idle, in slices of policy.idleWaitMs. wait(ms) blocks up to ms and returns true if input
+        // arrived; poll() checks what can't end a wait (the menu key, which only GetAsyncKeyState sees while the
+        // window is click-through) and returns true to wake. Returns after policy.idleFrameMs at the latest, so
+        // the frame's background work (config I/O completions, the config file watch) still runs, and at once
+        // if the overlay isn't idle. True if woken by wait() or poll().
+        template <typename Wait, typename Poll>
+        bool WaitIdle(Wait&& wait, Poll&& poll)
+        {
+            if (!IsIdle()) return false;
+            const unsigned int slice = policy.idleWaitMs > 0 ? policy.idleWaitMs : 1;
+            for (unsigned int waited = 0; waited < policy.idleFrameMs; waited += slice) {
+                if (wait(slice) || poll()) return true;
+                idleSlices++;
+            }
+            return false;
+        }
+    };
+}
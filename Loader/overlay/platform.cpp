@@ -0,0 +1,146 @@
+#include "platform.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace platform
+{
+    static constexpr size_t kMaxMappedSize = 1 << 20;
+
+#ifdef _WIN32
+    bool IsKeyDown(int vk)
+    {
+        return (GetAsyncKeyState(vk) & 0x8000) != 0;
+    }
+
+    std::string KeyName(int vk)
+    {
+        UINT scan = MapVirtualKeyA(vk, MAPVK_VK_TO_VSC);
+        LONG lParam = (scan << 16);
+        char name[64] = { 0 };
+        if (GetKeyNameTextA(lParam, name, (int)sizeof(name))) return std::string(name);
+        return std::string();
+    }
+
+    void SendLeftClick()
+    {
+        INPUT inputs[2] = {};
+        inputs[0].type = INPUT_MOUSE;
+        inputs[0].mi.dwFlags = MOUSEEVENTF_LEFTDOWN;
+        inputs[1].type = INPUT_MOUSE;
+        inputs[1].mi.dwFlags = MOUSEEVENTF_LEFTUP;
+        SendInput(2, inputs, sizeof(INPUT));
+    }
+
+    MappedFile::MappedFile(const std::string& path)
+    {
+        HANDLE h = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (h == INVALID_HANDLE_VALUE) return;
+        file = h;
+        opened = true;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(h, &fileSize) || fileSize.QuadPart == 0 || fileSize.QuadPart > static_cast<LONGLONG>(kMaxMappedSize)) return;
+        mapping = CreateFileMappingA(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return;
+        data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data) size = static_cast<size_t>(fileSize.QuadPart);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file) CloseHandle(file);
+    }
+
+    bool WriteFileDurable(const std::string& path, const void* data, size_t size)
+    {
+        const std::string tmpPath = path + ".tmp";
+        HANDLE h = CreateFileA(tmpPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (h == INVALID_HANDLE_VALUE) return false;
+        const char* p = static_cast<const char*>(data);
+        size_t left = size;
+        bool ok = true;
+        while (ok && left > 0) {
+            DWORD written = 0;
+            const DWORD chunk = left > 0x40000000 ? 0x40000000 : static_cast<DWORD>(left);
+            ok = WriteFile(h, p, chunk, &written, nullptr) && written > 0;
+            p += written;
+            left -= written;
+        }
+        ok = ok && FlushFileBuffers(h);
+        CloseHandle(h);
+        if (ok) ok = MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+        if (!ok) DeleteFileA(tmpPath.c_str());
+        return ok;
+    }
+#else
+    bool IsKeyDown(int) { return false; }
+    std::string KeyName(int) { return std::string(); }
+    void SendLeftClick() {}
+
+    // The mapping outlives the descriptor, so only data/size are kept
+    MappedFile::MappedFile(const std::string& path)
+    {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        opened = true;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0 && static_cast<size_t>(st.st_size) <= kMaxMappedSize) {
+            void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                data = view;
+                size = static_cast<size_t>(st.st_size);
+            }
+        }
+        close(fd);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (data) munmap(const_cast<void*>(data), size);
+    }
+
+    // The directory is synced too, otherwise the rename itself may not survive a crash
+    bool WriteFileDurable(const std::string& path, const void* data, size_t size)
+    {
+        const std::string tmpPath = path + ".tmp";
+        const int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        const char* p = static_cast<const char*>(data);
+        size_t left = size;
+        bool ok = true;
+        while (ok && left > 0) {
+            const ssize_t written = write(fd, p, left);
+            if (written < 0 && errno == EINTR) continue;
+            ok = written > 0;
+            if (ok) {
+                p += written;
+                left -= static_cast<size_t>(written);
+            }
+        }
+        ok = ok && fsync(fd) == 0;
+        ok = close(fd) == 0 && ok;
+        if (ok) ok = rename(tmpPath.c_str(), path.c_str()) == 0;
+        if (!ok) {
+            unlink(tmpPath.c_str());
+            return false;
+        }
+
+        const size_t slash = path.find_last_of('/');
+        const std::string dir = slash == std::string::npos ? std::string(".") : path.substr(0, slash + 1);
+        const int dirFd = open(dir.c_str(), O_RDONLY);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            close(dirFd);
+        }
+        return true;
+    }
+#endif
+}
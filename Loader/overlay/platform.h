@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// The few Win32 calls the menu and config code make (key state, key names, synthetic clicks, file I/O).
+// Everything above this layer builds without <Windows.h>, which is what lets the CMake build run the menu,
+// overlay and config code headless on Linux. On Windows the calls forward to the API, elsewhere they are
+// inert (no keyboard, no clicks) or use the POSIX equivalent.
+#ifdef _WIN32
+#include <Windows.h>
+#else
+// Virtual-key codes used by the config defaults and the key name fallbacks, same values as WinUser.h
+#define VK_LBUTTON  0x01
+#define VK_RBUTTON  0x02
+#define VK_XBUTTON1 0x05
+#define VK_PRIOR    0x21
+#define VK_NEXT     0x22
+#define VK_END      0x23
+#define VK_HOME     0x24
+#define VK_LEFT     0x25
+#define VK_UP       0x26
+#define VK_RIGHT    0x27
+#define VK_DOWN     0x28
+#define VK_INSERT   0x2D
+#define VK_DELETE   0x2E
+#endif
+
+namespace platform
+{
+    // GetAsyncKeyState: key or mouse button held right now
+    bool IsKeyDown(int vk);
+
+    // Keyboard layout name of a virtual key ("Insert", "F5"), empty if the platform has none
+    std::string KeyName(int vk);
+
+    // Left button down + up through SendInput
+    void SendLeftClick();
+
+    // Writes path + ".tmp", flushes it to the disk and renames it over path: CreateFile/WriteFile/FlushFileBuffers
+    // and MoveFileEx(REPLACE_EXISTING | WRITE_THROUGH) on Windows, write/fsync/rename elsewhere. After a crash the
+    // file is either the old or the new content, never a renamed file whose data was still in the cache.
+    bool WriteFileDurable(const std::string& path, const void* data, size_t size);
+
+    // Read-only mapping of a whole file (at most 1 MB), unmapped on scope exit
+    struct MappedFile {
+        const void* data = nullptr;
+        size_t size = 0;
+        bool opened = false;    // the file exists and could be opened, even if it is empty or too large
+
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+    private:
+        void* file = nullptr;
+        void* mapping = nullptr;
+    };
+}
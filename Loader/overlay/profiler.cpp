@@ -0,0 +1,240 @@
+#include "profiler.h"
+#include <algorithm>
+#include <fstream>
+
+namespace profiler
+{
+    // Render thread only, writer and readers alike. Sample n lives in g_ring[n % kHistorySize].
+    static FrameSample g_ring[kHistorySize];
+    static uint64_t g_written = 0;
+    static FrameSample g_current;
+    static std::chrono::steady_clock::time_point g_frameStart;
+    static uint64_t g_frameIndex = 0;
+
+    static_assert((kHistorySize & (kHistorySize - 1)) == 0, "kHistorySize must be a power of two");
+
+    void BeginFrame()
+    {
+        g_current = FrameSample();
+        g_current.frameIndex = g_frameIndex++;
+        g_frameStart = std::chrono::steady_clock::now();
+    }
+
+    void AddStageTime(Stage stage, uint64_t ns)
+    {
+        g_current.stageNs[static_cast<int>(stage)] += ns;
+    }
+
+    void AddDrawCallsSaved(int count)
+    {
+        g_current.drawCallsSaved += count;
+    }
+
+    void EndFrame(const ImDrawData* drawData, bool presented)
+    {
+        g_current.frameNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_frameStart).count());
+        g_current.presented = presented;
+        if (drawData && drawData->Valid)
+        {
+            g_current.vtxCount = drawData->TotalVtxCount;
+            g_current.idxCount = drawData->TotalIdxCount;
+            for (int n = 0; n < drawData->CmdListsCount; n++)
+                for (const ImDrawCmd& cmd : drawData->CmdLists[n]->CmdBuffer)
+                    if (cmd.UserCallback == nullptr && cmd.ElemCount > 0)
+                        g_current.drawCalls++;
+        }
+
+        g_ring[g_written & (kHistorySize - 1)] = g_current;
+        g_written++;
+    }
+
+    int CopyHistory(FrameSample* out, int maxCount)
+    {
+        const uint64_t count = std::min<uint64_t>(g_written, static_cast<uint64_t>(std::min(maxCount, kHistorySize)));
+        int copied = 0;
+        for (uint64_t i = g_written - count; i < g_written; i++)
+            out[copied++] = g_ring[i & (kHistorySize - 1)];
+        return copied;
+    }
+
+    static Percentiles ComputePercentiles(uint64_t* values, int count)
+    {
+        Percentiles p;
+        if (count <= 0) return p;
+        std::sort(values, values + count);
+        p.p50 = values[(count * 50) / 100];
+        p.p99 = values[std::min(count - 1, (count * 99) / 100)];
+        p.max = values[count - 1];
+        return p;
+    }
+
+    Summary Summarize()
+    {
+        static FrameSample history[kHistorySize];
+        static uint64_t values[kHistorySize];
+
+        Summary s;
+        s.frames = CopyHistory(history, kHistorySize);
+
+        auto collect = [&](auto get) {
+            for (int i = 0; i < s.frames; i++) values[i] = static_cast<uint64_t>(get(history[i]));
+            return ComputePercentiles(values, s.frames);
+        };
+        for (int st = 0; st < kStageCount; st++)
+            s.stage[st] = collect([st](const FrameSample& f) { return f.stageNs[st]; });
+        s.frame = collect([](const FrameSample& f) { return f.frameNs; });
+        s.vtxCount = collect([](const FrameSample& f) { return f.vtxCount; });
+        s.idxCount = collect([](const FrameSample& f) { return f.idxCount; });
+        s.drawCalls = collect([](const FrameSample& f) { return f.drawCalls; });
+        s.drawCallsSaved = collect([](const FrameSample& f) { return f.drawCallsSaved; });
+        return s;
+    }
+
+    static float ToMs(uint64_t ns) { return static_cast<float>(ns) / 1.0e6f; }
+
+    static const ImU32 kStageColors[kStageCount] = {
+        IM_COL32(120, 120, 130, 255), // MessagePump
+        IM_COL32(90, 140, 220, 255),  // NewFrame
+        IM_COL32(105, 64, 199, 255),  // menu::Draw
+        IM_COL32(70, 190, 160, 255),  // overlay::draw_gui
+        IM_COL32(220, 180, 70, 255),  // ImGui::Render
+        IM_COL32(230, 120, 60, 255),  // RenderDrawData
+        IM_COL32(200, 70, 90, 255),   // Present
+    };
+
+    // Stacked bar of the last frame's stages, scaled to a 60 Hz frame budget (or the frame, if longer)
+    static void DrawFlameBar(const FrameSample& last)
+    {
+        const uint64_t budgetNs = 16666667ull;
+        const uint64_t scaleNs = std::max<uint64_t>(budgetNs, last.frameNs);
+        const float width = ImGui::GetContentRegionAvail().x;
+        const float height = 18.0f;
+
+        ImDrawList* dl = ImGui::GetWindowDrawList();
+        ImVec2 p = ImGui::GetCursorScreenPos();
+        dl->AddRectFilled(p, ImVec2(p.x + width, p.y + height), IM_COL32(30, 32, 38, 255), 4.0f);
+
+        float x = p.x;
+        for (int st = 0; st < kStageCount; st++)
+        {
+            const float w = width * static_cast<float>(last.stageNs[st]) / static_cast<float>(scaleNs);
+            if (w <= 0.0f) continue;
+            ImVec2 a(x, p.y), b(x + std::max(w, 1.0f), p.y + height);
+            dl->AddRectFilled(a, b, kStageColors[st]);
+            if (ImGui::IsMouseHoveringRect(a, b))
+                ImGui::SetTooltip("%s: %.3f ms", kStageNames[st], ToMs(last.stageNs[st]));
+            x += w;
+        }
+        const float budgetX = p.x + width * static_cast<float>(budgetNs) / static_cast<float>(scaleNs);
+        dl->AddLine(ImVec2(budgetX, p.y - 2.0f), ImVec2(budgetX, p.y + height + 2.0f), IM_COL32(255, 255, 255, 120));
+        ImGui::Dummy(ImVec2(width, height));
+    }
+
+    void DrawPanel(bool* open)
+    {
+        ImGui::SetNextWindowSize(ImVec2(480, 0), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Profiler", open, ImGuiWindowFlags_NoSavedSettings)) {
+            ImGui::End();
+            return;
+        }
+
+        // Percentiles over the whole history are refreshed a few times a second, not every frame
+        static Summary summary;
+        static int refreshCountdown = 0;
+        if (--refreshCountdown <= 0) {
+            summary = Summarize();
+            refreshCountdown = 15;
+        }
+
+        FrameSample last;
+        if (CopyHistory(&last, 1) == 1) {
+            ImGui::Text("Last frame: %.3f ms%s", ToMs(last.frameNs), last.presented ? "" : " (not presented)");
+            DrawFlameBar(last);
+        }
+
+        if (ImGui::BeginTable("ProfilerStages", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+            ImGui::TableSetupColumn("Stage");
+            ImGui::TableSetupColumn("p50 ms");
+            ImGui::TableSetupColumn("p99 ms");
+            ImGui::TableSetupColumn("max ms");
+            ImGui::TableHeadersRow();
+            for (int st = 0; st <= kStageCount; st++) {
+                const bool total = (st == kStageCount);
+                const Percentiles& p = total ? summary.frame : summary.stage[st];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (total) ImGui::TextUnformatted("Frame");
+                else ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(kStageColors[st]), "%s", kStageNames[st]);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", ToMs(p.p50));
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", ToMs(p.p99));
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", ToMs(p.max));
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::Text("Vertices p50/max: %llu / %llu", (unsigned long long)summary.vtxCount.p50, (unsigned long long)summary.vtxCount.max);
+        ImGui::Text("Indices p50/max: %llu / %llu", (unsigned long long)summary.idxCount.p50, (unsigned long long)summary.idxCount.max);
+        ImGui::Text("Draw calls p50/max: %llu / %llu", (unsigned long long)summary.drawCalls.p50, (unsigned long long)summary.drawCalls.max);
+        ImGui::Text("Draw calls merged p50/max: %llu / %llu", (unsigned long long)summary.drawCallsSaved.p50, (unsigned long long)summary.drawCallsSaved.max);
+        ImGui::Text("Frames sampled: %d", summary.frames);
+
+        static const char* dumpStatus = "";
+        if (ImGui::Button("Dump CSV")) dumpStatus = DumpCsv("profile.csv") ? "Wrote profile.csv" : "Failed to write profile.csv";
+        ImGui::SameLine();
+        if (ImGui::Button("Dump JSON")) dumpStatus = DumpJson("profile.json") ? "Wrote profile.json" : "Failed to write profile.json";
+        if (dumpStatus[0]) { ImGui::SameLine(); ImGui::TextUnformatted(dumpStatus); }
+
+        ImGui::End();
+    }
+
+    bool DumpCsv(const char* path)
+    {
+        static FrameSample history[kHistorySize];
+        const int count = CopyHistory(history, kHistorySize);
+
+        std::ofstream ofs(path, std::ios::trunc);
+        if (!ofs) return false;
+        ofs << "frame,frame_ns";
+        for (int st = 0; st < kStageCount; st++) ofs << ',' << kStageNames[st] << "_ns";
+        ofs << ",vertices,indices,draw_calls,draw_calls_saved,presented\n";
+        for (int i = 0; i < count; i++) {
+            const FrameSample& f = history[i];
+            ofs << f.frameIndex << ',' << f.frameNs;
+            for (int st = 0; st < kStageCount; st++) ofs << ',' << f.stageNs[st];
+            ofs << ',' << f.vtxCount << ',' << f.idxCount << ',' << f.drawCalls << ',' << f.drawCallsSaved << ',' << (f.presented ? 1 : 0) << '\n';
+        }
+        return ofs.good();
+    }
+
+    bool DumpJson(const char* path)
+    {
+        static FrameSample history[kHistorySize];
+        const int count = CopyHistory(history, kHistorySize);
+        const Summary s = Summarize();
+
+        std::ofstream ofs(path, std::ios::trunc);
+        if (!ofs) return false;
+
+        auto writePercentiles = [&](const char* name, const Percentiles& p, bool last) {
+            ofs << "    \"" << name << "\": { \"p50\": " << p.p50 << ", \"p99\": " << p.p99 << ", \"max\": " << p.max << " }" << (last ? "\n" : ",\n");
+        };
+
+        ofs << "{\n  \"summary\": {\n";
+        for (int st = 0; st < kStageCount; st++) writePercentiles(kStageNames[st], s.stage[st], false);
+        writePercentiles("frame_ns", s.frame, false);
+        writePercentiles("vertices", s.vtxCount, false);
+        writePercentiles("indices", s.idxCount, false);
+        writePercentiles("draw_calls", s.drawCalls, false);
+        writePercentiles("draw_calls_saved", s.drawCallsSaved, true);
+        ofs << "  },\n  \"frames\": [\n";
+        for (int i = 0; i < count; i++) {
+            const FrameSample& f = history[i];
+            ofs << "    { \"frame\": " << f.frameIndex << ", \"frame_ns\": " << f.frameNs << ", \"stages_ns\": [";
+            for (int st = 0; st < kStageCount; st++) ofs << (st ? ", " : "") << f.stageNs[st];
+            ofs << "], \"vertices\": " << f.vtxCount << ", \"indices\": " << f.idxCount << ", \"draw_calls\": " << f.drawCalls << ", \"draw_calls_saved\": " << f.drawCallsSaved
+                << ", \"presented\": " << (f.presented ? "true" : "false") << " }" << (i + 1 < count ? ",\n" : "\n");
+        }
+        ofs << "  ]\n}\n";
+        return ofs.good();
+    }
+}
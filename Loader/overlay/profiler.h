@@ -0,0 +1,91 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#include <imgui.h>
+
+// Frame-time instrumentation for the render loop. The render thread records one sample per
+// frame into a ring; the panel and the CSV/JSON dumps read it back. Those run on the render
+// thread too (from the menu), so nothing here is synchronized: every function in this header
+// must be called from the render thread only. A call from the topmost monitor thread or the
+// config I/O thread (a dump, CopyHistory or Summarize included) races EndFrame's ring writes.
+namespace profiler
+{
+    enum class Stage : int {
+        MessagePump = 0,
+        NewFrame,
+        MenuDraw,
+        OverlayDraw,
+        Render,
+        RenderDrawData,
+        Present,
+        Count
+    };
+
+    inline constexpr const char* kStageNames[] = { "MessagePump", "NewFrame", "menu::Draw", "overlay::draw_gui", "ImGui::Render", "RenderDrawData", "Present" };
+    static_assert(IM_ARRAYSIZE(kStageNames) == static_cast<int>(Stage::Count), "every profiler stage needs a name");
+
+    inline constexpr int kStageCount = static_cast<int>(Stage::Count);
+    inline constexpr int kHistorySize = 512; // power of two
+
+    struct FrameSample {
+        uint64_t frameIndex = 0;
+        uint64_t stageNs[kStageCount] = {};
+        uint64_t frameNs = 0;
+        int vtxCount = 0;
+        int idxCount = 0;
+        int drawCalls = 0;
+        int drawCallsSaved = 0;     // folded away by the drawmerge pass
+        bool presented = false;
+    };
+
+    struct Percentiles {
+        uint64_t p50 = 0;
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+    };
+
+    struct Summary {
+        int frames = 0;
+        Percentiles stage[kStageCount];
+        Percentiles frame;
+        Percentiles vtxCount;
+        Percentiles idxCount;
+        Percentiles drawCalls;
+        Percentiles drawCallsSaved;
+    };
+
+    // Frame boundaries, called by the render loop
+    void BeginFrame();
+    void EndFrame(const ImDrawData* drawData, bool presented);
+
+    void AddStageTime(Stage stage, uint64_t ns);
+    void AddDrawCallsSaved(int count);
+
+    struct ScopedTimer {
+        Stage stage;
+        std::chrono::steady_clock::time_point start;
+
+        explicit ScopedTimer(Stage s) : stage(s), start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() {
+            AddStageTime(stage, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+    // Copies up to maxCount of the most recent samples (oldest first), returns how many were copied
+    int CopyHistory(FrameSample* out, int maxCount);
+
+    Summary Summarize();
+
+    // Profiler window with percentiles and a flame-style bar of the last frame
+    void DrawPanel(bool* open);
+
+    bool DumpCsv(const char* path);
+    bool DumpJson(const char* path);
+}
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(stage) profiler::ScopedTimer PROFILER_CONCAT(_profileScope, __LINE__)(stage)
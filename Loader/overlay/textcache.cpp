@@ -0,0 +1,357 @@
+#include "textcache.h"
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include <imgui_internal.h>
+
+namespace textcache
+{
+    AtlasStamp StampOf(const ImFont* font)
+    {
+        AtlasStamp stamp;
+        stamp.glyphs = font->Glyphs.Data;
+        stamp.glyphCount = font->Glyphs.Size;
+        if (const ImFontAtlas* atlas = font->ContainerAtlas)
+        {
+            stamp.texId = atlas->TexID;
+            stamp.texWidth = atlas->TexWidth;
+            stamp.texHeight = atlas->TexHeight;
+        }
+        stamp.fontSize = font->FontSize;
+        return stamp;
+    }
+
+    // Writes the quad of glyph with its pen at x, y. Same corners and UVs as ImFont::RenderText.
+    static void WriteQuad(ImDrawVert* v, const ImFontHotGlyph* glyph, float x, float y, float scale)
+    {
+        const float x1 = x + glyph->X0 * scale;
+        const float x2 = x + glyph->X1 * scale;
+        const float y1 = y + glyph->Y0 * scale;
+        const float y2 = y + glyph->Y1 * scale;
+        const ImU32 col = glyph->Colored ? ~IM_COL32_A_MASK : 0u;
+        v[0].pos = ImVec2(x1, y1); v[0].uv = ImVec2(glyph->U0, glyph->V0); v[0].col = col;
+        v[1].pos = ImVec2(x2, y1); v[1].uv = ImVec2(glyph->U1, glyph->V0); v[1].col = col;
+        v[2].pos = ImVec2(x2, y2); v[2].uv = ImVec2(glyph->U1, glyph->V1); v[2].col = col;
+        v[3].pos = ImVec2(x1, y2); v[3].uv = ImVec2(glyph->U0, glyph->V1); v[3].col = col;
+    }
+
+    // Glyph tables of one font at one size, resolved once per Shape()/ShapeBatch() call
+    struct FontTables {
+        const ImFontHotGlyph* hot;
+        unsigned int hotSize;
+        const ImWchar* lookup;
+        unsigned int lookupSize;
+        const ImFontGlyph* glyphs;
+        const ImFontGlyph* fallback;
+        float size;
+        float scale;
+    };
+
+    static FontTables TablesOf(const ImFont* font, float size)
+    {
+        return { font->HotGlyphs.Data, static_cast<unsigned int>(font->HotGlyphs.Size), font->IndexLookup.Data, static_cast<unsigned int>(font->IndexLookup.Size),
+            font->Glyphs.Data, font->FallbackGlyph, size, size / font->FontSize };
+    }
+
+    // ImFont::FindGlyph, inlined into the shaping loop (dense table first, like RenderText). Glyphs past the
+    // dense table are copied into cold so both cases hand back the same record type.
+    static const ImFontHotGlyph* LookupGlyph(const FontTables& t, unsigned int c, ImFontHotGlyph& cold)
+    {
+        if (c < t.hotSize)
+            return &t.hot[c];
+        const ImFontGlyph* glyph = t.fallback;
+        if (c < t.lookupSize && t.lookup[c] != static_cast<ImWchar>(-1))
+            glyph = &t.glyphs[t.lookup[c]];
+        if (!glyph)
+            return nullptr;
+        cold.Set(*glyph);
+        return &cold;
+    }
+
+    static void ShapeWith(Run& run, const FontTables& t, const char* text, const char* textEnd)
+    {
+        run.Vtx.resize(0);
+        run.Vtx.reserve(static_cast<int>(textEnd - text) * 4);
+        run.Size = ImVec2(0.0f, 0.0f);
+
+        ImDrawVert* out = run.Vtx.Data;
+        ImFontHotGlyph cold;
+        float x = 0.0f;
+        float y = 0.0f;
+        for (const char* s = text; s < textEnd; )
+        {
+            unsigned int c = static_cast<unsigned char>(*s);
+            if (c < 0x80)
+                s += 1;
+            else
+                s += ImTextCharFromUtf8(&c, s, textEnd);
+
+            if (c == '\n')
+            {
+                run.Size.x = ImMax(run.Size.x, x);
+                run.Size.y += t.size;
+                x = 0.0f;
+                y += t.size;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+
+            const ImFontHotGlyph* glyph = LookupGlyph(t, c, cold);
+            if (!glyph)
+                continue;
+            if (glyph->Visible)
+            {
+                WriteQuad(out, glyph, x, y, t.scale);
+                out += 4;
+            }
+            x += glyph->AdvanceX * t.scale;
+        }
+        run.Vtx.Size = static_cast<int>(out - run.Vtx.Data);
+
+        // Same rules as CalcTextSizeA for the last line
+        run.Size.x = ImMax(run.Size.x, x);
+        if (x > 0.0f || run.Size.y == 0.0f)
+            run.Size.y += t.size;
+    }
+
+    void Shape(Run& run, const ImFont* font, float size, const char* text, const char* textEnd)
+    {
+        if (!textEnd)
+            textEnd = text + strlen(text);
+        ShapeWith(run, TablesOf(font, size), text, textEnd);
+    }
+
+    void ShapeBatch(const ImFont* font, float size, const std::string* texts, size_t count, Run* runs)
+    {
+        const FontTables tables = TablesOf(font, size);
+        for (size_t i = 0; i < count; i++)
+            ShapeWith(runs[i], tables, texts[i].data(), texts[i].data() + texts[i].size());
+    }
+
+    bool Update(Block& block, const ImFont* font, float size, const std::vector<std::string>& texts)
+    {
+        const AtlasStamp stamp = StampOf(font);
+        if (block.font == font && block.size == size && block.stamp == stamp && block.texts == texts)
+            return false;
+
+        block.font = font;
+        block.size = size;
+        block.stamp = stamp;
+        block.texts = texts;
+        block.Runs.resize(texts.size());
+        ShapeBatch(font, size, texts.data(), texts.size(), block.Runs.data());
+
+        block.Size = ImVec2(0.0f, 0.0f);
+        for (const Run& run : block.Runs)
+        {
+            block.Size.x = ImMax(block.Size.x, run.Size.x);
+            block.Size.y += run.Size.y;
+        }
+        block.Layouts++;
+        return true;
+    }
+
+    void Blit(ImDrawList* dl, const Run& run, const ImVec2& pos, ImU32 col)
+    {
+        const int vtxCount = run.Vtx.Size;
+        if (vtxCount == 0 || (col & IM_COL32_A_MASK) == 0) return;
+
+        // Whole run outside the clip rect: nothing to emit (RenderText culls per glyph, the overlay
+        // labels are either fully on screen or not at all)
+        const float x = IM_TRUNC(pos.x);
+        const float y = IM_TRUNC(pos.y);
+        const ImVec4& clip = dl->_CmdHeader.ClipRect;
+        if (x > clip.z || y > clip.w || x + run.Size.x < clip.x || y + run.Size.y < clip.y) return;
+
+        const int idxCount = vtxCount / 4 * 6;
+        dl->PrimReserve(idxCount, vtxCount);
+
+        // Colored glyphs carry ~alpha mask in col, which turns col into the untinted color
+        const ImDrawVert* src = run.Vtx.Data;
+        ImDrawVert* vtx = dl->_VtxWritePtr;
+        for (int i = 0; i < vtxCount; i++)
+        {
+            vtx[i].pos.x = src[i].pos.x + x;
+            vtx[i].pos.y = src[i].pos.y + y;
+            vtx[i].uv = src[i].uv;
+            vtx[i].col = col | src[i].col;
+        }
+
+        ImDrawIdx* idx = dl->_IdxWritePtr;
+        unsigned int base = dl->_VtxCurrentIdx;
+        for (int q = 0; q < vtxCount / 4; q++, idx += 6, base += 4)
+        {
+            idx[0] = static_cast<ImDrawIdx>(base); idx[1] = static_cast<ImDrawIdx>(base + 1); idx[2] = static_cast<ImDrawIdx>(base + 2);
+            idx[3] = static_cast<ImDrawIdx>(base); idx[4] = static_cast<ImDrawIdx>(base + 2); idx[5] = static_cast<ImDrawIdx>(base + 3);
+        }
+
+        dl->_VtxWritePtr += vtxCount;
+        dl->_IdxWritePtr = idx;
+        dl->_VtxCurrentIdx = base;
+    }
+
+    // Word-at-a-time multiply/xorshift hash over the text, seeded with the font and size. Labels are
+    // short, so a byte-wise hash would spend more time in its multiply chain than the lookup itself.
+    static uint64_t KeyOf(const ImFont* font, float size, const char* text, size_t length)
+    {
+        constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+        uint32_t sizeBits;
+        memcpy(&sizeBits, &size, sizeof(sizeBits));
+        uint64_t hash = (reinterpret_cast<uintptr_t>(font) ^ (static_cast<uint64_t>(sizeBits) << 32) ^ length) * kMul;
+        for (; length >= 8; text += 8, length -= 8)
+        {
+            uint64_t word;
+            memcpy(&word, text, 8);
+            hash = (hash ^ word) * kMul;
+            hash ^= hash >> 29;
+        }
+        if (length > 0)
+        {
+            uint64_t word = 0;
+            memcpy(&word, text, length);
+            hash = (hash ^ word) * kMul;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+
+    const Run& Cache::Get(const ImFont* font, float size, const char* text, const char* textEnd)
+    {
+        if (!textEnd)
+            textEnd = text + strlen(text);
+        const size_t length = static_cast<size_t>(textEnd - text);
+
+        const uint64_t key = KeyOf(font, size, text, length);
+        size_t index = 0;
+        while (index < keys.size() && keys[index] != key)
+            index++;
+        if (index == keys.size())
+        {
+            keys.push_back(key);
+            entries.emplace_back();
+        }
+
+        Entry& entry = entries[index];
+        entry.lastFrame = frame;
+
+        const AtlasStamp stamp = StampOf(font);
+        const bool same = entry.font == font && entry.size == size && entry.stamp == stamp
+            && entry.text.size() == length && memcmp(entry.text.data(), text, length) == 0;
+        if (same)
+        {
+            hits++;
+            return entry.run;
+        }
+
+        // New entry, atlas rebuild or (very unlikely) a hash collision: reshape in place
+        entry.font = font;
+        entry.size = size;
+        entry.stamp = stamp;
+        entry.text.assign(text, length);
+        Shape(entry.run, font, size, text, textEnd);
+        shapes++;
+        return entry.run;
+    }
+
+    void Cache::NewFrame()
+    {
+        frame++;
+        if (frame % kMaxIdleFrames != 0) return;
+        for (size_t i = 0; i < keys.size(); )
+        {
+            if (frame - entries[i].lastFrame >= kMaxIdleFrames)
+            {
+                // Swap-remove, order doesn't matter
+                keys[i] = keys.back();
+                keys.pop_back();
+                entries[i] = std::move(entries.back());
+                entries.pop_back();
+                evictions++;
+            }
+            else
+                i++;
+        }
+    }
+
+    void Cache::Clear()
+    {
+        keys.clear();
+        entries.clear();
+    }
+
+    // Appends the quads of digits[from..] after the ones that are already in place
+    static void LayoutDigits(NumberLabel& label, int from)
+    {
+        label.Out.Vtx.resize(label.digitVtxStart[from]);
+        float x = label.digitX[from];
+        for (int i = from; i < label.digitCount; i++)
+        {
+            const int d = label.digits[i] - '0';
+            label.digitVtxStart[i] = label.Out.Vtx.Size;
+            label.digitX[i] = x;
+            if (label.digitVisible[d])
+            {
+                label.Out.Vtx.resize(label.Out.Vtx.Size + 4);
+                ImDrawVert* v = label.Out.Vtx.Data + label.Out.Vtx.Size - 4;
+                for (int k = 0; k < 4; k++)
+                {
+                    v[k] = label.digitVtx[d][k];
+                    v[k].pos.x += x;
+                }
+            }
+            x += label.digitAdvance[d];
+            label.DigitsShaped++;
+        }
+        label.digitVtxStart[label.digitCount] = label.Out.Vtx.Size;
+        label.digitX[label.digitCount] = x;
+        label.Out.Size = ImVec2(x, label.size);
+    }
+
+    void SetNumber(NumberLabel& label, const ImFont* font, float size, const char* prefix, int value)
+    {
+        char digits[NumberLabel::kMaxDigits + 1];
+        const int digitCount = snprintf(digits, sizeof(digits), "%d", value < 0 ? 0 : value);
+
+        const AtlasStamp stamp = StampOf(font);
+        if (label.font != font || label.size != size || label.stamp != stamp || label.prefix != prefix)
+        {
+            label.font = font;
+            label.size = size;
+            label.stamp = stamp;
+            label.prefix = prefix;
+            label.Rebuilds++;
+
+            const FontTables tables = TablesOf(font, size);
+            ImFontHotGlyph cold;
+            for (int d = 0; d < 10; d++)
+            {
+                const ImFontHotGlyph* glyph = LookupGlyph(tables, static_cast<unsigned int>('0' + d), cold);
+                label.digitVisible[d] = glyph && glyph->Visible;
+                label.digitAdvance[d] = glyph ? glyph->AdvanceX * tables.scale : 0.0f;
+                if (label.digitVisible[d])
+                    WriteQuad(label.digitVtx[d], glyph, 0.0f, 0.0f, tables.scale);
+            }
+
+            Shape(label.Out, font, size, prefix);
+            label.prefixVtx = label.Out.Vtx.Size;
+            label.prefixWidth = label.Out.Size.x;
+            label.digitVtxStart[0] = label.prefixVtx;
+            label.digitX[0] = label.prefixWidth;
+            label.digitCount = 0;
+            label.digits[0] = '\0';
+        }
+
+        // Digits before the first difference keep their quads (and their pen position)
+        int from = 0;
+        while (from < digitCount && from < label.digitCount && digits[from] == label.digits[from])
+            from++;
+        if (from == digitCount && from == label.digitCount)
+            return;
+
+        memcpy(label.digits, digits, digitCount + 1);
+        label.digitCount = digitCount;
+        LayoutDigits(label, from);
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <imgui.h>
+
+struct ImFontGlyph;
+
+// Shaped-text cache for overlay labels that rarely change (watermark, feature list, FPS label).
+// A string is decoded and looked up in the font once, the resulting glyph quads are kept around
+// (0,0) and every later frame only moves/tints them into the draw list with a single PrimReserve.
+namespace textcache
+{
+    // One string shaped at (0,0): 4 vertices per visible glyph, laid out like ImFont::RenderText
+    struct Run {
+        ImVector<ImDrawVert> Vtx;           // col is 0 for tinted glyphs, ~IM_COL32_A_MASK for colored (untinted) ones
+        ImVec2 Size = ImVec2(0.0f, 0.0f);   // same as ImFont::CalcTextSizeA(size, FLT_MAX, 0.0f, text)
+
+        int GlyphCount() const { return Vtx.Size / 4; }
+    };
+
+    // What a run depends on besides the text. Rebuilding the atlas reallocates the glyph table and
+    // usually the texture, so comparing these catches a rebuild without a hook into ImFontAtlas.
+    struct AtlasStamp {
+        const ImFontGlyph* glyphs = nullptr;
+        int glyphCount = 0;
+        ImTextureID texId = 0;
+        int texWidth = 0;
+        int texHeight = 0;
+        float fontSize = 0.0f;
+
+        bool operator==(const AtlasStamp& o) const {
+            return glyphs == o.glyphs && glyphCount == o.glyphCount && texId == o.texId && texWidth == o.texWidth && texHeight == o.texHeight && fontSize == o.fontSize;
+        }
+        bool operator!=(const AtlasStamp& o) const { return !(*this == o); }
+    };
+
+    AtlasStamp StampOf(const ImFont* font);
+
+    // Code that rebuilds the atlas in place should still call Cache::Clear(): the allocator may hand
+    // the new glyph table the old address.
+
+    // Shapes [text, textEnd) into run (replacing its contents). '\n' starts a new line, no wrapping.
+    void Shape(Run& run, const ImFont* font, float size, const char* text, const char* textEnd = nullptr);
+
+    // Shapes count strings at one size in one pass: the glyph tables and the scale are resolved once
+    // and the extents come out of the same loop that writes the quads.
+    void ShapeBatch(const ImFont* font, float size, const std::string* texts, size_t count, Run* runs);
+
+    // Strings laid out together at one size, e.g. the feature list
+    struct Block {
+        std::vector<Run> Runs;              // one per string, in order
+        ImVec2 Size = ImVec2(0.0f, 0.0f);   // widest run, sum of the run heights
+        unsigned int Layouts = 0;           // incremented on every re-layout
+
+        // What the runs were laid out from
+        const ImFont* font = nullptr;
+        float size = 0.0f;
+        AtlasStamp stamp;
+        std::vector<std::string> texts;
+    };
+
+    // Re-lays block out if the strings, font, size or atlas changed. Returns true if it did.
+    bool Update(Block& block, const ImFont* font, float size, const std::vector<std::string>& texts);
+
+    // Appends run at pos (truncated to whole pixels like RenderText) tinted with col.
+    // The draw list must have the font's atlas texture bound, same as for AddText().
+    void Blit(ImDrawList* dl, const Run& run, const ImVec2& pos, ImU32 col);
+
+    // Runs keyed by (font, size, text). Entries not asked for in kMaxIdleFrames frames are dropped.
+    // The overlay only ever has a few dozen labels, so entries live in a flat array searched by key.
+    struct Cache {
+        static constexpr unsigned int kMaxIdleFrames = 120;
+
+        // Cached run, shaped on first use and again after an atlas rebuild. Valid until the next Get().
+        const Run& Get(const ImFont* font, float size, const char* text, const char* textEnd = nullptr);
+
+        // Advances the frame counter and evicts idle entries. Call once per frame.
+        void NewFrame();
+        void Clear();
+        size_t Size() const { return keys.size(); }
+
+        uint64_t hits = 0;
+        uint64_t shapes = 0;
+        uint64_t evictions = 0;
+
+    private:
+        struct Entry {
+            const ImFont* font = nullptr;
+            float size = 0.0f;
+            std::string text;
+            AtlasStamp stamp;
+            unsigned int lastFrame = 0;
+            Run run;
+        };
+
+        std::vector<uint64_t> keys;     // keys[i] belongs to entries[i]
+        std::vector<Entry> entries;
+        unsigned int frame = 0;
+    };
+
+    // Label whose tail is a changing number ("OniV2 | FPS: 144"). The prefix is shaped once, the
+    // digits come from a per-font table of pre-shaped quads, and when the value changes only the
+    // digits from the first one that differs onward are re-laid out.
+    struct NumberLabel {
+        Run Out;                            // prefix + digits, what gets blitted
+
+        // Incremented per re-laid-out digit, and on every full rebuild (prefix, font or atlas change)
+        unsigned int DigitsShaped = 0;
+        unsigned int Rebuilds = 0;
+
+        // Layout state, only touched by SetNumber()
+        static constexpr int kMaxDigits = 11;
+
+        const ImFont* font = nullptr;
+        float size = 0.0f;
+        AtlasStamp stamp;
+        std::string prefix;
+        int prefixVtx = 0;
+        float prefixWidth = 0.0f;
+
+        // '0'..'9' shaped at (0,0)
+        ImDrawVert digitVtx[10][4] = {};
+        bool digitVisible[10] = {};
+        float digitAdvance[10] = {};
+
+        char digits[kMaxDigits + 1] = {};
+        int digitCount = 0;
+        int digitVtxStart[kMaxDigits + 1] = {};     // Out.Vtx index of each digit's first vertex
+        float digitX[kMaxDigits + 1] = {};          // pen x before each digit
+    };
+
+    // Updates label to prefix followed by value (negative values are clamped to 0)
+    void SetNumber(NumberLabel& label, const ImFont* font, float size, const char* prefix, int value);
+}
+
+// Overlay text drawn every frame goes through this cache
+inline textcache::Cache* g_textCache = new textcache::Cache();
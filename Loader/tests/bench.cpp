@@ -0,0 +1,264 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "harness.h"
+#include "heapcount.h"
+#include "overlay/overlay.h"
+#include "overlay/menu/configfile.h"
+#include "overlay/menu/configjson.h"
+
+
+// Headless benchmark: drives menu::Draw + overlay::draw_gui through ImGui without a window or renderer and
+// reports ns/frame, ImGui allocations/frame and vertex counts per scenario. Portable target of CMakeLists.txt,
+// not part of Loader.exe: overlay_bench [frames]
+namespace bench
+{
+    using harness::Image;
+    using harness::NsPerStep;
+    using harness::RasterizeReference;
+    using harness::StepFrame;
+
+    struct Options {
+        int frames = 600;
+        ImVec2 displaySize = ImVec2(1920.0f, 1080.0f);
+    };
+
+    // Counts every allocation ImGui makes (draw lists, windows, tables, ...)
+    static size_t g_allocCount = 0;
+
+    static void* CountingAlloc(size_t size, void*)
+    {
+        g_allocCount++;
+        return malloc(size);
+    }
+
+    static void CountingFree(void* ptr, void*)
+    {
+        free(ptr);
+    }
+
+    struct FrameStats {
+        double nsPerFrame = 0.0;
+        double allocsPerFrame = 0.0;
+        int vertices = 0;
+        int indices = 0;
+        int drawCalls = 0;
+        unsigned int configSyncs = 0;
+    };
+
+    static FrameStats Measure(int frames, bool menuOpen)
+    {
+        // Warm-up: first frames create windows and grow buffers
+        for (int i = 0; i < 10; i++)
+            StepFrame(menuOpen);
+
+        const unsigned int syncsBefore = overlay::ConfigSyncCount;
+        const size_t allocsBefore = g_allocCount;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; i++)
+            StepFrame(menuOpen);
+        const auto end = std::chrono::steady_clock::now();
+
+        FrameStats stats;
+        stats.nsPerFrame = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / frames;
+        stats.allocsPerFrame = static_cast<double>(g_allocCount - allocsBefore) / frames;
+        stats.configSyncs = overlay::ConfigSyncCount - syncsBefore;
+
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        stats.vertices = drawData->TotalVtxCount;
+        stats.indices = drawData->TotalIdxCount;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+            for (const ImDrawCmd& cmd : drawData->CmdLists[n]->CmdBuffer)
+                if (cmd.UserCallback == nullptr && cmd.ElemCount > 0)
+                    stats.drawCalls++;
+        return stats;
+    }
+
+    // Per crosshair shape, menu closed and open. The syncs column counts config syncs after the warm-up (0 for
+    // unchanged frames, checked in test_overlay).
+    static void RunFrameScenarios(const Options& options)
+    {
+        printf("%-14s %-6s %12s %14s %9s %9s %6s %6s\n", "crosshair", "menu", "ns/frame", "allocs/frame", "vertices", "indices", "draws", "syncs");
+        for (int type = 0; type < static_cast<int>(crosshair::Shape::Count); type++)
+        {
+            for (int menuOpen = 0; menuOpen < 2; menuOpen++)
+            {
+                config->crosshair.enabled = true;
+                config->crosshair.type = type;
+                MarkConfigDirty();
+
+                const FrameStats stats = Measure(options.frames, menuOpen != 0);
+                printf("%-14s %-6s %12.0f %14.2f %9d %9d %6d %6u\n", crosshair::kShapeNames[type], menuOpen ? "open" : "closed",
+                    stats.nsPerFrame, stats.allocsPerFrame, stats.vertices, stats.indices, stats.drawCalls, stats.configSyncs);
+            }
+        }
+    }
+
+    // The AoS loop menu::UpdateMenuParticles ran before the SoA store, kept as the baseline
+    struct LegacyParticle {
+        ImVec2 Position = ImVec2(0.0f, 0.0f);
+        ImVec2 Velocity = ImVec2(0.0f, 0.0f);
+        float Size = 0.0f;
+        float Alpha = 0.0f;
+        float Life = 0.0f;
+    };
+
+    static void UpdateLegacyParticles(std::vector<LegacyParticle>& ps, float deltaTime, const ImVec2& areaSize, std::mt19937& gen)
+    {
+        std::uniform_real_distribution<float> xDist(0.0f, 1.0f);
+        for (auto& p : ps) {
+            p.Position.x += p.Velocity.x * deltaTime;
+            p.Position.y += p.Velocity.y * deltaTime;
+            if (p.Position.x < -40.0f) p.Position.x = areaSize.x + 40.0f;
+            if (p.Position.x > areaSize.x + 40.0f) p.Position.x = -40.0f;
+            if (p.Position.y > areaSize.y + 20.0f) {
+                p.Position.y = -(5.0f + xDist(gen) * 40.0f);
+                p.Position.x = xDist(gen) * areaSize.x;
+            }
+        }
+    }
+
+    static void RunParticleScenarios()
+    {
+        const ImVec2 area(660.0f, 480.0f);
+        const float deltaTime = 1.0f / 60.0f;
+        const int steps = 2000;
+
+        printf("\n%-10s %14s %14s %14s\n", "particles", "AoS ns", "SoA scalar ns", "SoA SIMD ns");
+        for (size_t count : { static_cast<size_t>(50), static_cast<size_t>(500), static_cast<size_t>(5000) })
+        {
+            particles::ParticleStore store;
+            particles::Spawn(store, count, area, particles::SpawnParams());
+
+            std::vector<LegacyParticle> legacy(count);
+            for (size_t i = 0; i < count; i++) {
+                legacy[i].Position = ImVec2(store.x[i], store.y[i]);
+                legacy[i].Velocity = ImVec2(store.vx[i], store.vy[i]);
+                legacy[i].Size = store.size[i];
+                legacy[i].Alpha = store.alpha[i];
+            }
+            std::mt19937 gen(1234);
+
+            particles::ParticleStore scalarStore = store;
+            const double aos = NsPerStep(steps, [&] { UpdateLegacyParticles(legacy, deltaTime, area, gen); });
+            const double scalar = NsPerStep(steps, [&] { particles::IntegrateScalar(scalarStore, deltaTime, area); });
+            const double simd = NsPerStep(steps, [&] { particles::Integrate(store, deltaTime, area); });
+            printf("%-10zu %14.0f %14.0f %14.0f\n", count, aos, scalar, simd);
+        }
+
+        // Respawn RNG: what Spawn/Respawn used to draw from vs the pool's generator
+        const int numbers = 1 << 20;
+        std::mt19937 mt(1234);
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+        particles::Rng xoshiro(1234);
+        float sink = 0.0f;
+        const double mtNs = NsPerStep(numbers, [&] { sink += dist(mt); });
+        const double xoshiroNs = NsPerStep(numbers, [&] { sink += xoshiro.NextFloat(); });
+        printf("\nRNG ns/number: mt19937 %.2f, xoshiro128+ %.2f (%.0f)\n", mtNs, xoshiroNs, sink);
+    }
+
+    // Emits the particles into a scratch draw list, either as circles or as sprite quads
+    static void RunParticleDrawScenarios()
+    {
+        const ImVec2 area(660.0f, 480.0f);
+        const int steps = 500;
+
+        printf("\n%-10s %12s %12s %12s %12s\n", "particles", "circle ns", "circle vtx", "sprite ns", "sprite vtx");
+        for (size_t count : { static_cast<size_t>(50), static_cast<size_t>(500), static_cast<size_t>(5000) })
+        {
+            particles::ParticleStore store;
+            particles::Spawn(store, count, area, particles::SpawnParams());
+
+            ImDrawList dl(ImGui::GetDrawListSharedData());
+            auto emit = [&](bool sprite) {
+                dl._ResetForNewFrame();
+                dl.PushTextureID(ImGui::GetIO().Fonts->TexID);
+                dl.PushClipRectFullScreen();
+                if (sprite)
+                    particles::Draw(&dl, store, ImVec2(0.0f, 0.0f), area);
+                else
+                    particles::DrawCircles(&dl, store, ImVec2(0.0f, 0.0f), area);
+            };
+
+            const double circleNs = NsPerStep(steps, [&] { emit(false); });
+            const int circleVtx = dl.VtxBuffer.Size;
+            const double spriteNs = NsPerStep(steps, [&] { emit(true); });
+            const int spriteVtx = dl.VtxBuffer.Size;
+            printf("%-10zu %12.0f %12d %12.0f %12d\n", count, circleNs, circleVtx, spriteNs, spriteVtx);
+        }
+    }
+
+    // Menu frame (particles included) with and without the shape cache; the draw data comparison is in test_drawlist
+    static void RunShapeCacheScenarios(const Options& options)
+    {
+        printf("\nShape cache (AddCircleFilled, rounded AddRectFilled)\n");
+        config->crosshair.enabled = true;
+        config->crosshair.type = 0;
+        MarkConfigDirty();
+        GImDrawListShapeCache = false;
+        const FrameStats without = Measure(options.frames, true);
+        GImDrawListShapeCache = true;
+        const FrameStats with = Measure(options.frames, true);
+        printf("  menu frame ns: %.0f without the cache, %.0f with it\n", without.nsPerFrame, with.nsPerFrame);
+    }
+
+    // JSON export/import: load latency and allocations of the SAX, DOM and binary paths on the same config;
+    // the checks are in test_configjson
+    static void RunJsonScenarios()
+    {
+        printf("\nConfig JSON\n");
+
+        Config source;
+        source.crosshair.size = 27;
+        source.crosshair.color[1] = 0.1f;
+        source.particles.particleSpeed = 1.7f;
+        source.autoclicker.humanize = false;
+        const std::string text = configjson::Export(source);
+        std::vector<uint8_t> binary;
+        configfile::Serialize(source, binary);
+
+        printf("  %-12s %10s %14s %10s\n", "path", "bytes", "ns/load", "allocs");
+        auto measure = [&](const char* name, size_t bytes, auto&& load) {
+            const int loads = 20000;
+            const size_t allocsBefore = heapcount::Allocations();
+            const double ns = NsPerStep(loads, load);
+            const double allocs = static_cast<double>(heapcount::Allocations() - allocsBefore) / loads;
+            printf("  %-12s %10zu %14.0f %10.2f\n", name, bytes, ns, allocs);
+        };
+        Config sink;
+        measure("binary", binary.size(), [&] { configfile::Parse(binary.data(), binary.size(), sink); });
+        measure("json SAX", text.size(), [&] { configjson::Import(text.data(), text.size(), sink); });
+        measure("json DOM", text.size(), [&] { configjson::ImportDom(text.data(), text.size(), sink); });
+    }
+
+    int Run(const Options& options)
+    {
+        ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
+        harness::CreateContext(options.displaySize);
+
+        const Config savedConfig = *config;
+        printf("Headless benchmark: %d frames per scenario, %.0fx%.0f\n\n", options.frames, options.displaySize.x, options.displaySize.y);
+        RunFrameScenarios(options);
+        RunParticleScenarios();
+        RunParticleDrawScenarios();
+        RunShapeCacheScenarios(options);
+        RunJsonScenarios();
+        *config = savedConfig;
+        MarkConfigDirty();
+
+        harness::DestroyContext();
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::Options options;
+    if (argc > 1 && atoi(argv[1]) > 0) options.frames = atoi(argv[1]);
+    return bench::Run(options);
+}
@@ -0,0 +1,179 @@
+#include "harness.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+#include "overlay/overlay.h"
+
+namespace harness
+{
+    Checks::Checks(const char* title)
+    {
+        printf("%s\n", title);
+    }
+
+    void Checks::operator()(const char* name, bool ok)
+    {
+        printf("  %-44s %s\n", name, ok ? "ok" : "FAILED");
+        if (!ok) failures++;
+    }
+
+    void CreateContext(ImVec2 displaySize)
+    {
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = displaySize;
+        io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+
+        menu::InitStyle();
+
+        // No renderer: building the atlas is enough for NewFrame()
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+        // NewFrame() fills in the shared draw list data (font, full-screen clip rect, line UVs) that
+        // standalone ImDrawLists read
+        StepFrame(false);
+    }
+
+    void DestroyContext()
+    {
+        ImGui::DestroyContext();
+    }
+
+    void StepFrame(bool menuOpen)
+    {
+        ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        if (menuOpen) menu::Draw();
+        overlay::draw_gui();
+        ImGui::Render();
+    }
+
+    static void RasterizeTriangle(const ImDrawVert* v[3], const ImVec2& off, const int scissor[4], const unsigned char* tex, int texW, int texH, Image& image)
+    {
+        float x[3], y[3];
+        for (int i = 0; i < 3; i++)
+        {
+            x[i] = v[i]->pos.x - off.x;
+            y[i] = v[i]->pos.y - off.y;
+        }
+        float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+        if (area == 0.0f)
+            return;
+        if (area < 0.0f)
+        {
+            std::swap(x[1], x[2]);
+            std::swap(y[1], y[2]);
+            std::swap(v[1], v[2]);
+            area = -area;
+        }
+
+        // Edge i is opposite vertex i. A pixel centre exactly on an edge belongs to one of the two triangles sharing it.
+        bool owns[3];
+        for (int i = 0; i < 3; i++)
+        {
+            const int a = (i + 1) % 3, b = (i + 2) % 3;
+            const float dx = x[b] - x[a], dy = y[b] - y[a];
+            owns[i] = dy > 0.0f || (dy == 0.0f && dx < 0.0f);
+        }
+
+        // Attributes the three vertices agree on aren't interpolated
+        const bool flatColor = v[0]->col == v[1]->col && v[0]->col == v[2]->col;
+        const bool flatUv = v[0]->uv.x == v[1]->uv.x && v[0]->uv.x == v[2]->uv.x && v[0]->uv.y == v[1]->uv.y && v[0]->uv.y == v[2]->uv.y;
+        const float invArea = 1.0f / area;
+        float col[3][4];
+        ImVec2 uv[3];
+        for (int i = 0; i < 3; i++)
+        {
+            for (int c = 0; c < 4; c++)
+                col[i][c] = static_cast<float>((v[i]->col >> (8 * c)) & 0xFF) * invArea;
+            uv[i] = ImVec2(v[i]->uv.x * invArea, v[i]->uv.y * invArea);
+        }
+
+        const int px0 = std::max(scissor[0], static_cast<int>(std::ceil(std::min({ x[0], x[1], x[2] }) - 0.5f)));
+        const int py0 = std::max(scissor[1], static_cast<int>(std::ceil(std::min({ y[0], y[1], y[2] }) - 0.5f)));
+        const int px1 = std::min(scissor[2] - 1, static_cast<int>(std::floor(std::max({ x[0], x[1], x[2] }) - 0.5f)));
+        const int py1 = std::min(scissor[3] - 1, static_cast<int>(std::floor(std::max({ y[0], y[1], y[2] }) - 0.5f)));
+        for (int py = py0; py <= py1; py++)
+        {
+            for (int px = px0; px <= px1; px++)
+            {
+                const float cx = px + 0.5f, cy = py + 0.5f;
+                float w[3];
+                bool inside = true;
+                for (int i = 0; i < 3 && inside; i++)
+                {
+                    const int a = (i + 1) % 3, b = (i + 2) % 3;
+                    w[i] = (x[b] - x[a]) * (cy - y[a]) - (y[b] - y[a]) * (cx - x[a]);
+                    inside = w[i] > 0.0f || (w[i] == 0.0f && owns[i]);
+                }
+                if (!inside)
+                    continue;
+
+                // Interpolated as sum of w[i] * (value[i] / area): one multiply per vertex, no divide per pixel
+                float rgba[4];
+                for (int c = 0; c < 4; c++)
+                    rgba[c] = flatColor ? static_cast<float>((v[0]->col >> (8 * c)) & 0xFF) : w[0] * col[0][c] + w[1] * col[1][c] + w[2] * col[2][c];
+                const float u = flatUv ? v[0]->uv.x : w[0] * uv[0].x + w[1] * uv[1].x + w[2] * uv[2].x;
+                const float t = flatUv ? v[0]->uv.y : w[0] * uv[0].y + w[1] * uv[1].y + w[2] * uv[2].y;
+                const int tx = std::min(texW - 1, std::max(0, static_cast<int>(u * texW)));
+                const int ty = std::min(texH - 1, std::max(0, static_cast<int>(t * texH)));
+                const unsigned char* texel = tex + (static_cast<size_t>(ty) * texW + tx) * 4;
+
+                uint32_t& dst = image.pixels[static_cast<size_t>(py) * image.width + px];
+                const float srcA = rgba[3] * texel[3] * (1.0f / (255.0f * 255.0f));
+                uint32_t out = 0;
+                for (int c = 0; c < 3; c++)
+                {
+                    const float src = rgba[c] * texel[c] * (1.0f / 255.0f);
+                    const float value = src * srcA + static_cast<float>((dst >> (8 * c)) & 0xFF) * (1.0f - srcA);
+                    out |= static_cast<uint32_t>(std::min(255.0f, value) + 0.5f) << (8 * c);
+                }
+                const float alpha = srcA * 255.0f + static_cast<float>(dst >> 24) * (1.0f - srcA);
+                dst = out | (static_cast<uint32_t>(std::min(255.0f, alpha) + 0.5f) << 24);
+            }
+        }
+    }
+
+    void RasterizeReference(const ImDrawData* drawData, Image& image)
+    {
+        unsigned char* tex = nullptr;
+        int texW = 0, texH = 0;
+        ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&tex, &texW, &texH);
+
+        image.width = static_cast<int>(drawData->DisplaySize.x);
+        image.height = static_cast<int>(drawData->DisplaySize.y);
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0u);
+        const ImVec2 off = drawData->DisplayPos;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            const ImDrawList* list = drawData->CmdLists[n];
+            for (const ImDrawCmd& cmd : list->CmdBuffer)
+            {
+                if (cmd.UserCallback != nullptr)
+                    continue;
+                const ImVec2 clipMin(cmd.ClipRect.x - off.x, cmd.ClipRect.y - off.y);
+                const ImVec2 clipMax(cmd.ClipRect.z - off.x, cmd.ClipRect.w - off.y);
+                if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y)
+                    continue;
+                const int scissor[4] = {
+                    std::max(0, static_cast<int>(static_cast<long>(clipMin.x))), std::max(0, static_cast<int>(static_cast<long>(clipMin.y))),
+                    std::min(image.width, static_cast<int>(static_cast<long>(clipMax.x))), std::min(image.height, static_cast<int>(static_cast<long>(clipMax.y))),
+                };
+                const ImDrawVert* vtx = list->VtxBuffer.Data + cmd.VtxOffset;
+                const ImDrawIdx* idx = list->IdxBuffer.Data + cmd.IdxOffset;
+                for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3)
+                {
+                    const ImDrawVert* tri[3] = { &vtx[idx[i]], &vtx[idx[i + 1]], &vtx[idx[i + 2]] };
+                    RasterizeTriangle(tri, off, scissor, tex, texW, texH, image);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <imgui.h>
+
+// Shared by the headless tests and overlay_bench: check reporting, an ImGui context with the overlay's
+// style and font atlas but no window or renderer, frame stepping and a scalar reference rasterizer.
+namespace harness
+{
+    // Prints every check as it is made; Result() is the process exit code, non-zero if any check failed
+    struct Checks {
+        int failures = 0;
+
+        explicit Checks(const char* title);
+        void operator()(const char* name, bool ok);
+        int Result() const { return failures == 0 ? 0 : 1; }
+    };
+
+    // menu::InitStyle() builds the atlas with the particle sprite, same order as load(), then one frame is run
+    void CreateContext(ImVec2 displaySize = ImVec2(1920.0f, 1080.0f));
+    void DestroyContext();
+
+    // One frame at 60 Hz: the menu if open, the overlay, ImGui::Render()
+    void StepFrame(bool menuOpen);
+
+    template <typename Fn>
+    double NsPerStep(int steps, Fn&& step)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < steps; i++)
+            step();
+        const auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / steps;
+    }
+
+    // RGBA8 image (straight alpha), cleared to transparent black like the overlay's render target
+    struct Image {
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> pixels;
+    };
+
+    // Scalar rasterizer for ImDrawData with the pipeline state of imgui_impl_dx11: clip rects truncated to whole
+    // pixels, pixel-centre coverage with a top-left style tie rule, the font atlas sampled at the nearest texel,
+    // SrcAlpha/InvSrcAlpha blending for color and One/InvSrcAlpha for alpha. Slow, it's the oracle (the golden
+    // image) for imgui_impl_soft, which has to produce the same float arithmetic per pixel.
+    void RasterizeReference(const ImDrawData* drawData, Image& image);
+}
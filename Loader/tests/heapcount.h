@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+
+// Counts calls to the global operator new, for the per-load allocation numbers of the config formats.
+// heapcount.cpp replaces operator new/delete for the whole executable it is linked into, so it is only
+// part of overlay_bench; Loader.exe and the tests keep the standard library's allocator.
+namespace heapcount
+{
+    size_t Allocations();
+}
@@ -0,0 +1,139 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "harness.h"
+#include "overlay/menu/configfile.h"
+#include "overlay/menu/menu.h"
+
+// Appends one record to a tagged file and fixes up the header, to fake a file from another build
+static void AppendRecord(std::vector<uint8_t>& file, uint16_t id, configfile::FieldType type, const void* value, uint8_t size)
+{
+    const configfile::RecordHeader rec = { id, type, size };
+    const uint8_t* recBytes = reinterpret_cast<const uint8_t*>(&rec);
+    file.insert(file.end(), recBytes, recBytes + sizeof(rec));
+    file.insert(file.end(), static_cast<const uint8_t*>(value), static_cast<const uint8_t*>(value) + size);
+
+    configfile::Header header;
+    memcpy(&header, file.data(), sizeof(header));
+    header.fieldCount++;
+    header.payloadSize += static_cast<uint32_t>(sizeof(rec) + size);
+    header.crc32 = configfile::Checksum(file.data() + header.headerSize, header.payloadSize);
+    memcpy(file.data(), &header, sizeof(header));
+}
+
+// Compatibility checks for the config format against configs/133.cfg (a raw dump from the first
+// Config layout) and against files from newer/older builds.
+int main()
+{
+    harness::Checks check("Config format");
+
+    Config legacy;
+    const configfile::LoadResult legacyResult = configfile::Load(LOADER_SOURCE_DIR "/configs/133.cfg", legacy);
+    check("133.cfg loads as legacy", legacyResult.status == configfile::Status::Legacy);
+    check("133.cfg menu key / crosshair size", legacy.menu.menuKey == VK_INSERT && legacy.crosshair.size == 20);
+    check("133.cfg cps seeds min and max", legacy.autoclicker.minCps == 10 && legacy.autoclicker.maxCps == 10 && legacy.autoclicker.key == VK_XBUTTON1);
+    check("133.cfg missing fields keep defaults", legacy.autoclicker.mode == 0 && legacy.autoclicker.humanize);
+    check("133.cfg particles", legacy.particles.enabled && legacy.particles.particleCount == 50.0f);
+    check("133.cfg needs no clamping", legacyResult.clamped == 0);
+
+    // Round trip: what we write reads back into the same bytes
+    Config source;
+    source.crosshair.size = 33;
+    source.crosshair.color[2] = 0.25f;
+    source.autoclicker.humanize = false;
+    std::vector<uint8_t> file, again;
+    configfile::Serialize(source, file);
+    Config parsed;
+    const configfile::LoadResult roundTrip = configfile::Parse(file.data(), file.size(), parsed);
+    configfile::Serialize(parsed, again);
+    check("round trip", roundTrip.status == configfile::Status::Ok && file == again);
+
+    // Newer build: an unknown id and a known id with a different type are skipped
+    std::vector<uint8_t> newer = file;
+    const int32_t unknownValue = 7;
+    const float wrongType = 3.0f;
+    AppendRecord(newer, 999, configfile::FieldType::Int32, &unknownValue, sizeof(unknownValue));
+    AppendRecord(newer, 6, configfile::FieldType::Float32, &wrongType, sizeof(wrongType));
+    configfile::LoadResult newerResult = configfile::Parse(newer.data(), newer.size(), parsed);
+    check("newer file: unknown fields skipped", newerResult.status == configfile::Status::Ok && newerResult.skipped == 2 && parsed.crosshair.size == 33);
+
+    // Older build: only the first record, everything else defaults
+    std::vector<uint8_t> older(file.begin(), file.begin() + sizeof(configfile::Header));
+    configfile::Header olderHeader;
+    memcpy(&olderHeader, older.data(), sizeof(olderHeader));
+    olderHeader.fieldCount = 0;
+    olderHeader.payloadSize = 0;
+    olderHeader.crc32 = configfile::Checksum(nullptr, 0);
+    memcpy(older.data(), &olderHeader, sizeof(olderHeader));
+    const bool vsync = false;
+    AppendRecord(older, 1, configfile::FieldType::Bool, &vsync, sizeof(vsync));
+    configfile::LoadResult olderResult = configfile::Parse(older.data(), older.size(), parsed);
+    check("older file: missing fields default", olderResult.status == configfile::Status::Ok && !parsed.menu.vsync && parsed.crosshair.size == Config().crosshair.size);
+
+    std::vector<uint8_t> corrupt = file;
+    corrupt.back() ^= 0xFF;
+    check("corrupt payload rejected", configfile::Parse(corrupt.data(), corrupt.size(), parsed).status == configfile::Status::ChecksumMismatch);
+    check("truncated file rejected", !configfile::Parse(file.data(), file.size() - 1, parsed).ok());
+
+    // Values the menu can't produce, from a hand-edited or damaged file: clamped or reset to the default
+    Config wild;
+    wild.crosshair.size = -4;
+    wild.crosshair.thickness = 1000;
+    wild.crosshair.type = 42;
+    wild.crosshair.color[1] = NAN;
+    wild.crosshair.color[3] = 7.0f;
+    wild.autoclicker.minCps = 25;
+    wild.autoclicker.maxCps = 3;
+    wild.particles.particleCount = NAN;
+    wild.particles.particleSpeed = -INFINITY;
+    wild.particles.particleSize = 1e30f;
+    std::vector<uint8_t> wildFile;
+    configfile::Serialize(wild, wildFile);
+    const configfile::LoadResult wildResult = configfile::Parse(wildFile.data(), wildFile.size(), parsed);
+    check("out-of-range fields counted", wildResult.ok() && wildResult.clamped == 8);
+    check("crosshair size/thickness/type clamped", parsed.crosshair.size == 1 && parsed.crosshair.thickness == 10 &&
+        parsed.crosshair.type == 6);
+    check("NaN color resets, color clamped to 1", parsed.crosshair.color[1] == 1.0f && parsed.crosshair.color[3] == 1.0f);
+    check("max cps raised to min cps", parsed.autoclicker.minCps == 25 && parsed.autoclicker.maxCps == 25);
+    check("NaN/inf particle values reset to defaults", parsed.particles.particleCount == Config().particles.particleCount &&
+        parsed.particles.particleSpeed == Config().particles.particleSpeed && parsed.particles.particleSize == 10.0f);
+    wild = Config();
+    wild.particles.particleCount = -50.0f;
+    configfile::Serialize(wild, wildFile);
+    configfile::Parse(wildFile.data(), wildFile.size(), parsed);
+    const float negative = parsed.particles.particleCount;
+    wild.particles.particleCount = 1e9f;
+    configfile::Serialize(wild, wildFile);
+    configfile::Parse(wildFile.data(), wildFile.size(), parsed);
+    check("particle count clamped to the pool", negative == 0.0f && parsed.particles.particleCount == particles::kMaxCount);
+
+    // 0 is "no key" for every key field, not something to clamp
+    Config unbound;
+    unbound.menu.menuKey = 0;
+    unbound.aimbot.key = 0;
+    unbound.autoclicker.key = 0;
+    configfile::Serialize(unbound, wildFile);
+    const configfile::LoadResult unboundResult = configfile::Parse(wildFile.data(), wildFile.size(), parsed);
+    check("unbound keys (0) load as 0", unboundResult.ok() && unboundResult.clamped == 0 && parsed.menu.menuKey == 0 &&
+        parsed.aimbot.key == 0 && parsed.autoclicker.key == 0);
+
+    // Save goes through a flushed temp file; nothing is left behind and the result loads
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "oni-test-configfile";
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+    const std::string path = (dir / "saved.cfg").string();
+    Config reloaded;
+    const bool saved = configfile::Save(path, source) && configfile::Save(path, source);
+    check("save replaces the file, no temp left", saved && !std::filesystem::exists(path + ".tmp") &&
+        configfile::Load(path, reloaded).status == configfile::Status::Ok && configfile::Compare(source, reloaded).Empty());
+    check("save into a missing directory fails", !configfile::Save((dir / "missing" / "x.cfg").string(), source));
+    std::filesystem::remove_all(dir, ec);
+
+    const double parseNs = harness::NsPerStep(100000, [&] { configfile::Parse(file.data(), file.size(), parsed); });
+    printf("  parse %zu bytes: %.0f ns\n", file.size(), parseNs);
+    return check.Result();
+}
@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "harness.h"
+#include "overlay/crosshair.h"
+#include "overlay/menu/configfile.h"
+#include "overlay/menu/configjson.h"
+#include "overlay/menu/menu.h"
+#include "overlay/menu/particles.h"
+
+// JSON export/import: round trip, SAX and DOM agreeing, foreign and malformed documents, and out-of-range
+// values pulled into range on import. Load latency and allocations are in overlay_bench.
+int main()
+{
+    harness::Checks check("Config JSON");
+
+    Config source;
+    source.crosshair.size = 27;
+    source.crosshair.color[1] = 0.1f;
+    source.particles.particleSpeed = 1.7f;
+    source.autoclicker.humanize = false;
+    const std::string text = configjson::Export(source);
+
+    Config sax, dom;
+    const configjson::ImportResult saxResult = configjson::Import(text.data(), text.size(), sax);
+    const configjson::ImportResult domResult = configjson::ImportDom(text.data(), text.size(), dom);
+    check("round trip through JSON", saxResult.ok && saxResult.skipped == 0 && saxResult.clamped == 0 && configfile::Compare(source, sax).Empty());
+    check("SAX and DOM agree", domResult.ok && configfile::Compare(sax, dom).Empty() && saxResult.applied == domResult.applied);
+
+    const char* foreign = "{ \"format\": \"oni-config\", \"version\": 2, \"future\": { \"a\": [ 1, { \"b\": 2 } ] },"
+        " \"crosshair\": { \"size\": 9, \"glow\": true, \"color\": [ 0.5, \"red\" ] } }";
+    Config partial;
+    const configjson::ImportResult foreignResult = configjson::Import(foreign, strlen(foreign), partial);
+    check("unknown keys skipped, missing fields default", foreignResult.ok && foreignResult.version == 2 && partial.crosshair.size == 9 &&
+        partial.crosshair.color[0] == 0.5f && partial.crosshair.color[1] == Config().crosshair.color[1] && partial.menu.menuKey == Config().menu.menuKey);
+    check("malformed document rejected", !configjson::Import(text.data(), text.size() / 2, partial).ok);
+
+    // A hand-edited file gets the same clamping as a binary one, on both parsers
+    const char* outOfRange = "{ \"format\": \"oni-config\", \"version\": 1,"
+        " \"crosshair\": { \"size\": 500, \"thickness\": -3, \"color\": [ 2.0, 0.5, -1.0, 1.0 ], \"type\": 99 },"
+        " \"autoclicker\": { \"minCps\": 20, \"maxCps\": 5 },"
+        " \"particles\": { \"particleCount\": 100000.0, \"particleSpeed\": 1.5 } }";
+    Config clampedSax, clampedDom;
+    const configjson::ImportResult clampSax = configjson::Import(outOfRange, strlen(outOfRange), clampedSax);
+    const configjson::ImportResult clampDom = configjson::ImportDom(outOfRange, strlen(outOfRange), clampedDom);
+    check("out-of-range values clamped", clampSax.ok && clampSax.clamped > 0 && clampedSax.crosshair.size == 50 && clampedSax.crosshair.thickness == 1 &&
+        clampedSax.crosshair.color[0] == 1.0f && clampedSax.crosshair.color[2] == 0.0f && clampedSax.crosshair.type < static_cast<int>(crosshair::Shape::Count) &&
+        clampedSax.autoclicker.maxCps >= clampedSax.autoclicker.minCps && clampedSax.particles.particleCount == particles::kMaxCount);
+    check("in-range values untouched", clampedSax.crosshair.color[1] == 0.5f && clampedSax.particles.particleSpeed == 1.5f);
+    check("SAX and DOM clamp alike", clampDom.ok && clampDom.clamped == clampSax.clamped && configfile::Compare(clampedSax, clampedDom).Empty());
+    return check.Result();
+}
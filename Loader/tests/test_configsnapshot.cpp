@@ -0,0 +1,63 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "harness.h"
+#include "overlay/menu/configsnapshot.h"
+
+// Config snapshots: reader threads pin and check snapshots while the writer publishes as fast as it
+// can. Every published config has size == thickness == its publish number, so a torn or recycled
+// snapshot shows up as a mismatch. Labelled "stress", like configio it is meant to run under ThreadSanitizer too.
+int main()
+{
+    harness::Checks check("Config snapshots");
+
+    Config edited;
+    edited.crosshair.size = edited.crosshair.thickness = 1;
+    configsnapshot::Holder holder(edited);
+
+    const int readerCount = 4;
+    const unsigned int publishes = 100000;
+    std::atomic<bool> done{ false };
+    std::atomic<int> started{ 0 };
+    std::atomic<int> torn{ 0 }, backwards{ 0 };
+    std::atomic<uint64_t> reads{ 0 };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; r++) {
+        readers.emplace_back([&] {
+            uint64_t lastVersion = 0, count = 0;
+            while (!done.load()) {
+                configsnapshot::Snapshot snapshot = holder.Acquire();
+                if (snapshot->crosshair.size != snapshot->crosshair.thickness || static_cast<uint64_t>(snapshot->crosshair.size) != snapshot.Version()) torn++;
+                if (snapshot.Version() < lastVersion) backwards++;
+                lastVersion = snapshot.Version();
+                if (count++ == 0) started++;
+            }
+            reads += count;
+        });
+    }
+
+    while (started.load() < readerCount)
+        std::this_thread::yield();
+
+    // Generation 1 is what the holder started with
+    const auto start = std::chrono::steady_clock::now();
+    unsigned int generation = 1;
+    while (holder.published < publishes) {
+        edited.crosshair.size = edited.crosshair.thickness = static_cast<int>(holder.published + 1);
+        if (holder.Publish(edited, generation + 1)) generation++;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    done = true;
+    for (auto& thread : readers) thread.join();
+
+    check("no torn or recycled snapshots", torn == 0);
+    check("versions never go backwards per reader", backwards == 0);
+    check("unchanged generation doesn't publish", holder.Publish(edited, generation) && holder.published == publishes);
+    printf("  %u publishes (%llu skipped, all slots pinned), %llu reads, %.0f ns/publish\n", publishes,
+        static_cast<unsigned long long>(holder.skipped), static_cast<unsigned long long>(reads.load()),
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / publishes);
+    return check.Result();
+}
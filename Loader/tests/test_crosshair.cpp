@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "harness.h"
+#include "overlay/crosshair.h"
+
+#include <imgui_impl_soft.h>
+
+// crosshair::Build/Place/Blit against the per-frame drawing the overlay did before the geometry cache
+// (end points rotated one by one, then AddLine/AddTriangle/AddCircle), both rasterized with imgui_impl_soft.
+// Every shape, rotated or not, on an integer and a half-pixel center.
+static ImVec2 RotatePoint(const ImVec2& p, const ImVec2& center, float angleRad)
+{
+    if (angleRad == 0.0f) return p;
+    const float s = p.x - center.x, t = p.y - center.y;
+    const float ca = cosf(angleRad), sa = sinf(angleRad);
+    return ImVec2(center.x + s * ca - t * sa, center.y + s * sa + t * ca);
+}
+
+static void DrawDirect(ImDrawList* dl, crosshair::Shape shape, const ImVec2& center, int r, int lineThickness, float angleRad, ImU32 col)
+{
+    const float thickness = static_cast<float>((lineThickness > 1) ? lineThickness : 1);
+    const double pi = 3.14159265358979323846;
+    auto line = [&](ImVec2 a, ImVec2 b) { dl->AddLine(RotatePoint(a, center, angleRad), RotatePoint(b, center, angleRad), col, thickness); };
+    switch (shape)
+    {
+    case crosshair::Shape::Dot:
+        dl->AddCircleFilled(center, r * 0.5f, col);
+        break;
+    case crosshair::Shape::Plus:
+        line(ImVec2(center.x - r, center.y), ImVec2(center.x + r, center.y));
+        line(ImVec2(center.x, center.y - r), ImVec2(center.x, center.y + r));
+        break;
+    case crosshair::Shape::Cross:
+        line(ImVec2(center.x - r, center.y - r), ImVec2(center.x + r, center.y + r));
+        line(ImVec2(center.x + r, center.y - r), ImVec2(center.x - r, center.y + r));
+        break;
+    case crosshair::Shape::Triangle:
+        dl->AddTriangle(RotatePoint(ImVec2(center.x, center.y - r), center, angleRad),
+            RotatePoint(ImVec2(center.x - (0.866f * r), center.y + r / 2.0f), center, angleRad),
+            RotatePoint(ImVec2(center.x + (0.866f * r), center.y + r / 2.0f), center, angleRad), col, thickness);
+        break;
+    case crosshair::Shape::Circle:
+        dl->AddCircle(center, static_cast<float>(r), col, 0, thickness);
+        break;
+    case crosshair::Shape::Pinwheel:
+        for (int i = 0; i < 4; i++)
+        {
+            const double ang = pi / 4.0 + i * (pi / 2.0);
+            line(ImVec2(center.x + static_cast<float>(cos(ang) * (r * 0.35)), center.y + static_cast<float>(sin(ang) * (r * 0.35))),
+                ImVec2(center.x + static_cast<float>(cos(ang) * r), center.y + static_cast<float>(sin(ang) * r)));
+        }
+        dl->AddCircleFilled(center, r * 0.12f, col);
+        break;
+    case crosshair::Shape::Windmill1954:
+    {
+        const int vTopY = static_cast<int>(center.y - (2.0f * r));
+        const int vBotY = static_cast<int>(center.y + (2.0f * r));
+        const int hHalf = static_cast<int>(2.0f * r);
+        const int tip = static_cast<int>(2.0f * r);
+        line(ImVec2(center.x, static_cast<float>(vTopY)), ImVec2(center.x, static_cast<float>(vBotY)));
+        line(ImVec2(center.x - hHalf, center.y), ImVec2(center.x + hHalf, center.y));
+        line(ImVec2(center.x, static_cast<float>(vTopY)), ImVec2(center.x + tip, static_cast<float>(vTopY)));
+        line(ImVec2(center.x, static_cast<float>(vBotY)), ImVec2(center.x - tip, static_cast<float>(vBotY)));
+        line(ImVec2(center.x + hHalf, center.y), ImVec2(center.x + hHalf, center.y + tip));
+        line(ImVec2(center.x - hHalf, center.y), ImVec2(center.x - hHalf, center.y - tip));
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+int main()
+{
+    harness::Checks check("Crosshair geometry cache");
+    harness::CreateContext();
+    ImGui_ImplSoft_Init();
+    ImGui_ImplSoft_NewFrame();
+
+    const ImVec2 display(256.0f, 256.0f);
+    ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+    ImDrawList list(shared);
+    ImDrawData data;
+    auto render = [&](auto&& draw, harness::Image& image) {
+        list._ResetForNewFrame();
+        list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        list.PushClipRect(ImVec2(0.0f, 0.0f), display);
+        draw(&list);
+        list._PopUnusedDrawCmd();
+        data.Clear();
+        data.Valid = true;
+        data.DisplaySize = display;
+        data.CmdLists.push_back(&list);
+        data.CmdListsCount = 1;
+        data.TotalVtxCount = list.VtxBuffer.Size;
+        data.TotalIdxCount = list.IdxBuffer.Size;
+        image.width = static_cast<int>(display.x);
+        image.height = static_cast<int>(display.y);
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0u);
+        ImGui_ImplSoft_Target target = { image.pixels.data(), image.width, image.height, image.width, true };
+        ImGui_ImplSoft_RenderDrawData(&data, &target);
+    };
+    // Pixels with a channel more than 2 apart
+    auto countDiffering = [](const harness::Image& a, const harness::Image& b) {
+        int count = 0;
+        for (size_t i = 0; i < a.pixels.size(); i++)
+            for (int shift = 0; shift < 32; shift += 8)
+                if (abs(static_cast<int>((a.pixels[i] >> shift) & 0xFF) - static_cast<int>((b.pixels[i] >> shift) & 0xFF)) > 2) {
+                    count++;
+                    break;
+                }
+        return count;
+    };
+
+    printf("  pixels that differ, worst frame\n  %-14s %10s %10s %10s\n", "shape", "unrotated", "rotated", "half-pixel");
+    const ImU32 col = IM_COL32(40, 220, 90, 255);
+    const ImVec2 centers[] = { ImVec2(128.0f, 128.0f), ImVec2(128.0f, 127.5f) };
+    const float angles[] = { 0.0f, 0.7f, 2.5f };
+    crosshair::Geometry geo;
+    harness::Image direct, cached;
+    int worstUnrotated = 0, worstRotated = 0, worstHalf = 0;
+    for (int type = 0; type < static_cast<int>(crosshair::Shape::Count); type++)
+    {
+        const crosshair::Shape shape = static_cast<crosshair::Shape>(type);
+        int shapeWorst[3] = { 0, 0, 0 };
+        for (const ImVec2& center : centers)
+        {
+            for (const float angle : angles)
+            {
+                for (const int thickness : { 1, 3 })
+                {
+                    crosshair::Params params;
+                    params.shape = shape;
+                    params.size = 20;
+                    params.thickness = thickness;
+                    params.centerFracY = (shape == crosshair::Shape::Windmill1954) ? center.y - floorf(center.y) : 0.0f;
+                    if (crosshair::NeedsRebuild(geo, params, shared))
+                        crosshair::Build(geo, params, shared);
+                    crosshair::Place(geo, center, angle, col);
+
+                    render([&](ImDrawList* dl) { DrawDirect(dl, shape, center, params.size, thickness, angle, col); }, direct);
+                    render([&](ImDrawList* dl) { crosshair::Blit(dl, geo); }, cached);
+                    const int diff = countDiffering(direct, cached);
+                    const int column = (center.y != floorf(center.y)) ? 2 : (angle != 0.0f ? 1 : 0);
+                    shapeWorst[column] = std::max(shapeWorst[column], diff);
+                }
+            }
+        }
+        printf("  %-14s %10d %10d %10d\n", crosshair::kShapeNames[type], shapeWorst[0], shapeWorst[1], shapeWorst[2]);
+        worstUnrotated = std::max(worstUnrotated, shapeWorst[0]);
+        worstRotated = std::max(worstRotated, shapeWorst[1]);
+        worstHalf = std::max(worstHalf, shapeWorst[2]);
+    }
+    // Same vertices up to float rounding (offsets and center are added in a different order), which can flip
+    // a pixel whose center lies exactly on an edge. A rotated half-pixel offset shifts whole edges instead.
+    check("unrotated: same pixels as direct", worstUnrotated <= 2);
+    check("rotated: same pixels as direct", worstRotated <= 2);
+    check("half-pixel center: same pixels as direct", worstHalf <= 2);
+
+    ImGui_ImplSoft_Shutdown();
+    harness::DestroyContext();
+    return check.Result();
+}
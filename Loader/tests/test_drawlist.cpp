@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "harness.h"
+#include "overlay/overlay.h"
+
+#include <imgui_internal.h>
+
+// AddPolyline/AddConvexPolyFilled with the SSE normal and fringe kernels against the scalar loops: random
+// polylines (closed or not, thin, thick and textured, repeated points) must give the same bytes, then the
+// time per shape.
+static void PathKernels(harness::Checks& check)
+{
+    printf("\nPolyline and convex fill kernels\n");
+
+    ImDrawList simd(ImGui::GetDrawListSharedData()), scalar(ImGui::GetDrawListSharedData());
+    auto begin = [](ImDrawList& dl, ImDrawListFlags flags) {
+        dl._ResetForNewFrame();
+        dl.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        dl.PushClipRectFullScreen();
+        dl.Flags = flags;
+    };
+
+    std::mt19937 gen(144);
+    std::uniform_real_distribution<float> pos(-300.0f, 2000.0f), step(-3.0f, 3.0f), width(0.2f, 7.0f);
+    const ImDrawListFlags modes[] = { ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill,
+        ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill, ImDrawListFlags_None };
+    std::vector<ImVec2> points;
+    bool identical = true;
+    int polylines = 0;
+    for (int round = 0; round < 3000; round++)
+    {
+        const ImDrawListFlags flags = modes[gen() % IM_ARRAYSIZE(modes)];
+        const int count = 2 + static_cast<int>(gen() % 40);
+        points.resize(count);
+        if (round % 3 == 0)
+        {
+            for (ImVec2& p : points)
+                p = ImVec2(pos(gen), pos(gen));
+        }
+        else
+        {
+            // Walks with repeated points (zero length segments)
+            ImVec2 p(pos(gen), pos(gen));
+            for (ImVec2& q : points)
+            {
+                q = p;
+                if (gen() % 5 != 0)
+                    p = ImVec2(p.x + step(gen), p.y + step(gen));
+            }
+        }
+        const float thickness = (round & 1) ? static_cast<float>(1 + gen() % 6) : width(gen);
+        const ImDrawFlags closed = (gen() & 1) ? ImDrawFlags_Closed : ImDrawFlags_None;
+        for (bool kernels : { true, false })
+        {
+            GImDrawListSimdPaths = kernels;
+            ImDrawList& dl = kernels ? simd : scalar;
+            begin(dl, flags);
+            dl.AddPolyline(points.data(), count, IM_COL32(200, 100, 50, 255), closed, thickness);
+            dl.AddConvexPolyFilled(points.data(), count, IM_COL32(20, 100, 250, 200));
+        }
+        identical = identical && simd.VtxBuffer.Size == scalar.VtxBuffer.Size && simd.IdxBuffer.Size == scalar.IdxBuffer.Size
+            && memcmp(simd.VtxBuffer.Data, scalar.VtxBuffer.Data, simd.VtxBuffer.Size * sizeof(ImDrawVert)) == 0
+            && memcmp(simd.IdxBuffer.Data, scalar.IdxBuffer.Data, simd.IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+        polylines++;
+    }
+    GImDrawListSimdPaths = true;
+    printf("  %d random polylines + fills compared\n", polylines);
+
+    // The crosshair's circle outline and lines, a thick ring, the particle-sized and menu-sized fills
+    std::vector<ImVec2> ring(64);
+    for (int i = 0; i < 64; i++)
+    {
+        const float a = -2.0f * IM_PI * static_cast<float>(i) / 64.0f;
+        ring[i] = ImVec2(960.0f + cosf(a) * 40.0f, 540.0f + sinf(a) * 40.0f);
+    }
+    struct Workload {
+        const char* name;
+        std::function<void(ImDrawList&)> draw;
+    };
+    const ImDrawListFlags aa = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill;
+    const Workload workloads[] = {
+        { "AddCircle r40, 1.5 px", [](ImDrawList& dl) { dl.AddCircle(ImVec2(960.0f, 540.0f), 40.0f, IM_COL32_WHITE, 0, 1.5f); } },
+        { "AddCircle r40, 6 px", [](ImDrawList& dl) { dl.AddCircle(ImVec2(960.0f, 540.0f), 40.0f, IM_COL32_WHITE, 0, 6.0f); } },
+        { "64-point polyline, 3 px", [&](ImDrawList& dl) { dl.AddPolyline(ring.data(), 64, IM_COL32_WHITE, ImDrawFlags_None, 3.0f); } },
+        { "64-point convex fill", [&](ImDrawList& dl) { dl.AddConvexPolyFilled(ring.data(), 64, IM_COL32_WHITE); } },
+        { "4 crosshair lines, 2 px", [](ImDrawList& dl) {
+            for (int i = 0; i < 4; i++)
+                dl.AddLine(ImVec2(960.0f, 540.0f), ImVec2(960.0f + (i & 1 ? 12.0f : 0.0f), 540.0f + (i & 1 ? 0.0f : 12.0f)), IM_COL32_WHITE, 2.0f);
+        } },
+    };
+    const int steps = 2000;
+    printf("  %-26s %12s %12s\n", "shape", "scalar ns", "SSE ns");
+    for (const Workload& workload : workloads)
+    {
+        double ns[2] = {};
+        for (bool kernels : { false, true })
+        {
+            GImDrawListSimdPaths = kernels;
+            begin(simd, aa);
+            ns[kernels ? 1 : 0] = harness::NsPerStep(steps, [&] {
+                simd._ResetForNewFrame();
+                simd.PushClipRectFullScreen();
+                workload.draw(simd);
+            });
+        }
+        printf("  %-26s %12.0f %12.0f\n", workload.name, ns[0], ns[1]);
+    }
+    GImDrawListSimdPaths = true;
+
+    check("SSE kernels byte-identical to scalar", identical);
+}
+
+// AddCircleFilled/AddRectFilled through the shape cache against the tessellating path: random shapes with and
+// without AA fill, then what the menu draws per frame.
+static void ShapeCache(harness::Checks& check)
+{
+    printf("\nShape cache (AddCircleFilled, rounded AddRectFilled)\n");
+
+    ImDrawList cached(ImGui::GetDrawListSharedData()), tessellated(ImGui::GetDrawListSharedData());
+    auto begin = [](ImDrawList& dl, bool aa) {
+        dl._ResetForNewFrame();
+        dl.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        dl.PushClipRectFullScreen();
+        dl.Flags = aa ? ImDrawListFlags_AntiAliasedFill : ImDrawListFlags_None;
+    };
+
+    // Same indices, uvs and colors; AA vertices may move by the normal's rounding, everything else is exact
+    float maxDeviation = 0.0f;
+    bool layoutMatches = true, pointsExact = true;
+    auto compare = [&](bool aa) {
+        layoutMatches = layoutMatches && cached.VtxBuffer.Size == tessellated.VtxBuffer.Size && cached.IdxBuffer.Size == tessellated.IdxBuffer.Size
+            && memcmp(cached.IdxBuffer.Data, tessellated.IdxBuffer.Data, cached.IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+        if (!layoutMatches)
+            return;
+        for (int i = 0; i < cached.VtxBuffer.Size; i++)
+        {
+            const ImDrawVert& a = cached.VtxBuffer[i];
+            const ImDrawVert& b = tessellated.VtxBuffer[i];
+            layoutMatches = layoutMatches && a.uv.x == b.uv.x && a.uv.y == b.uv.y && a.col == b.col;
+            maxDeviation = std::max(maxDeviation, std::max(fabsf(a.pos.x - b.pos.x), fabsf(a.pos.y - b.pos.y)));
+            pointsExact = pointsExact && (aa || (a.pos.x == b.pos.x && a.pos.y == b.pos.y));
+        }
+    };
+
+    std::mt19937 gen(1954);
+    std::uniform_real_distribution<float> pos(-50.0f, 1000.0f), size(0.0f, 300.0f), radius(0.0f, 90.0f);
+    const ImDrawFlags cornerFlags[] = { ImDrawFlags_None, ImDrawFlags_RoundCornersAll, ImDrawFlags_RoundCornersTop, ImDrawFlags_RoundCornersBottom,
+        ImDrawFlags_RoundCornersLeft, ImDrawFlags_RoundCornersTopLeft | ImDrawFlags_RoundCornersBottomRight, ImDrawFlags_RoundCornersBottomLeft, ImDrawFlags_RoundCornersNone };
+    int shapes = 0;
+    for (int round = 0; round < 2000; round++)
+    {
+        const bool aa = (round & 1) == 0;
+        for (bool cache : { true, false })
+        {
+            GImDrawListShapeCache = cache;
+            std::mt19937 local = gen;
+            ImDrawList& dl = cache ? cached : tessellated;
+            begin(dl, aa);
+            for (int i = 0; i < 8; i++)
+            {
+                const ImVec2 a(pos(local), pos(local));
+                const ImVec2 b(a.x + size(local), a.y + size(local));
+                const ImU32 col = IM_COL32(local() & 255, 90, 200, 1 + local() % 255);
+                dl.AddCircleFilled(a, radius(local), col);
+                dl.AddRectFilled(a, b, col, radius(local) * 0.5f, cornerFlags[local() % IM_ARRAYSIZE(cornerFlags)]);
+            }
+            if (!cache)
+                gen = local;
+        }
+        compare(aa);
+        shapes += 16;
+    }
+    GImDrawListShapeCache = true;
+    printf("  %d random shapes, largest AA vertex deviation %.2e px\n", shapes, maxDeviation);
+
+    // What menu::Draw fills per frame: window, nav items and their accent bars, panel, pills, toggles
+    auto menuShapes = [](ImDrawList& dl) {
+        dl.AddRectFilled(ImVec2(100.0f, 80.0f), ImVec2(900.0f, 620.0f), IM_COL32(8, 9, 11, 242), 16.0f);
+        for (int i = 0; i < 5; i++)
+        {
+            const float y = 150.0f + i * 44.0f;
+            dl.AddRectFilled(ImVec2(116.0f, y), ImVec2(276.0f, y + 38.0f), IM_COL32(15, 18, 23, 255), 10.0f);
+            dl.AddRectFilled(ImVec2(124.0f, y + 10.0f), ImVec2(128.0f, y + 28.0f), IM_COL32(140, 80, 255, 255), 4.0f);
+        }
+        dl.AddRectFilled(ImVec2(290.0f, 140.0f), ImVec2(884.0f, 604.0f), IM_COL32(13, 14, 17, 230), 12.0f);
+        for (int i = 0; i < 6; i++)
+        {
+            const float y = 160.0f + i * 40.0f;
+            dl.AddRectFilled(ImVec2(310.0f, y), ImVec2(420.0f, y + 26.0f), IM_COL32(30, 30, 40, 255), 12.0f);
+            dl.AddRectFilled(ImVec2(820.0f, y + 4.0f), ImVec2(860.0f, y + 24.0f), IM_COL32(140, 80, 255, 255), 10.0f);
+            dl.AddCircleFilled(ImVec2(850.0f, y + 14.0f), 7.0f, IM_COL32_WHITE);
+        }
+    };
+    const int steps = 1000;
+    printf("  %-14s %14s %14s\n", "menu shapes", "tessellate ns", "cached ns");
+    double ns[2] = {};
+    for (bool cache : { false, true })
+    {
+        GImDrawListShapeCache = cache;
+        ns[cache ? 1 : 0] = harness::NsPerStep(steps, [&] { begin(cached, true); menuShapes(cached); });
+    }
+    printf("  %-14s %14.0f %14.0f\n", "", ns[0], ns[1]);
+    GImDrawListShapeCache = false;
+    begin(tessellated, true);
+    menuShapes(tessellated);
+    GImDrawListShapeCache = true;
+    compare(true);
+
+    // Whole menu frame (particles included)
+    config->crosshair.enabled = true;
+    config->crosshair.type = 0;
+    MarkConfigDirty();
+    auto menuFrame = [](bool cache) {
+        GImDrawListShapeCache = cache;
+        for (int i = 0; i < 3; i++)
+            harness::StepFrame(true);
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        return std::make_pair(drawData->TotalVtxCount, drawData->TotalIdxCount);
+    };
+    const std::pair<int, int> without = menuFrame(false);
+    const std::pair<int, int> with = menuFrame(true);
+
+    check("same indices, uvs and colors", layoutMatches);
+    check("points bit-identical without AA", pointsExact);
+    check("AA fringe within 1/1000 px", maxDeviation < 1e-3f);
+    check("menu frame keeps its vertex count", with == without);
+}
+
+// ImDrawList paths that have a fast variant behind a global switch: each has to give the same draw data as
+// the path it replaces
+int main()
+{
+    harness::Checks check("Draw list");
+    harness::CreateContext();
+    ShapeCache(check);
+    PathKernels(check);
+    harness::DestroyContext();
+    return check.Result();
+}
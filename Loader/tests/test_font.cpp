@@ -0,0 +1,122 @@
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+
+#include "harness.h"
+
+#include <imgui_internal.h>
+
+// ImFont::CalcTextSizeA/RenderText with and without the printable-ASCII fast path and the dense glyph
+// table. Output has to be bit-identical.
+int main()
+{
+    harness::Checks check("Font fast paths");
+    harness::CreateContext();
+
+    // What the menu and the overlay print, plus a few strings that leave the fast path
+    const char* strings[] = {
+        "Crosshair", "Autoclicker", "Min CPS", "Humanize", "Particle Speed", "OniV2 | FPS: 144", "Save Config",
+        "Export JSON", "133.cfg - 356 bytes, format v1, modified 2026-10-17 12:00", "Windmill1954",
+        "Gr\xc3\xb6\xc3\x9f" "e / Dicke", "two\nlines\r\nthree", "tab\tand \x7f del", "\xe2\x9c\x93 ok",
+    };
+    ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    ImDrawList fast(ImGui::GetDrawListSharedData());
+    ImDrawList scalar(ImGui::GetDrawListSharedData());
+    auto emit = [&](ImDrawList& dl, bool fastPath, float size, const char* text) {
+        GImFontAsciiFastPath = fastPath;
+        dl._ResetForNewFrame();
+        dl.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        dl.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(220.0f, 400.0f));
+        dl.AddText(font, size, ImVec2(3.5f, 7.25f), IM_COL32_WHITE, text);
+    };
+
+    bool sizesMatch = true, verticesMatch = true, truncationMatches = true;
+    for (const char* text : strings)
+    {
+        for (float size : { 13.0f, 16.0f, 31.0f })
+        {
+            GImFontAsciiFastPath = true;
+            const ImVec2 fastSize = font->CalcTextSizeA(size, FLT_MAX, 0.0f, text);
+            const char* fastRemaining = nullptr;
+            const ImVec2 fastClamped = font->CalcTextSizeA(size, 60.0f, 0.0f, text, nullptr, &fastRemaining);
+            GImFontAsciiFastPath = false;
+            const ImVec2 scalarSize = font->CalcTextSizeA(size, FLT_MAX, 0.0f, text);
+            const char* scalarRemaining = nullptr;
+            const ImVec2 scalarClamped = font->CalcTextSizeA(size, 60.0f, 0.0f, text, nullptr, &scalarRemaining);
+            sizesMatch = sizesMatch && memcmp(&fastSize, &scalarSize, sizeof(ImVec2)) == 0;
+            truncationMatches = truncationMatches && fastRemaining == scalarRemaining && memcmp(&fastClamped, &scalarClamped, sizeof(ImVec2)) == 0;
+
+            emit(fast, true, size, text);
+            emit(scalar, false, size, text);
+            verticesMatch = verticesMatch && fast.VtxBuffer.Size == scalar.VtxBuffer.Size && fast.IdxBuffer.Size == scalar.IdxBuffer.Size
+                && memcmp(fast.VtxBuffer.Data, scalar.VtxBuffer.Data, fast.VtxBuffer.Size * sizeof(ImDrawVert)) == 0
+                && memcmp(fast.IdxBuffer.Data, scalar.IdxBuffer.Data, fast.IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+        }
+    }
+    check("CalcTextSizeA bit-identical", sizesMatch);
+    check("max_width truncation identical", truncationMatches);
+    check("RenderText vertices identical (clipped)", verticesMatch);
+
+    // Dense glyph records: the same text through HotGlyphs and through IndexLookup + Glyphs (table swapped out)
+    ImVector<ImFontHotGlyph> hotGlyphs;
+    auto withoutHotGlyphs = [&](auto&& fn) {
+        hotGlyphs.swap(font->HotGlyphs);
+        fn();
+        hotGlyphs.swap(font->HotGlyphs);
+    };
+    bool hotMatches = font->HotGlyphs.Size >= 0x100;
+    for (const char* text : strings)
+    {
+        for (bool fastPath : { false, true })
+        {
+            emit(fast, fastPath, 16.0f, text);
+            withoutHotGlyphs([&] { emit(scalar, fastPath, 16.0f, text); });
+            hotMatches = hotMatches && fast.VtxBuffer.Size == scalar.VtxBuffer.Size
+                && memcmp(fast.VtxBuffer.Data, scalar.VtxBuffer.Data, fast.VtxBuffer.Size * sizeof(ImDrawVert)) == 0;
+        }
+    }
+    font->SetGlyphVisible('A', false);
+    const bool hidden = !font->HotGlyphs['A'].Visible;
+    font->SetGlyphVisible('A', true);
+    check("dense glyph table matches IndexLookup", hotMatches);
+    check("dense glyph table follows SetGlyphVisible", hidden && font->HotGlyphs['A'].Visible);
+
+    // ns for the first ten strings (the menu labels)
+    const int steps = 20000;
+    printf("  %-12s %14s %14s\n", "path", "calc ns", "render ns");
+    for (bool fastPath : { false, true })
+    {
+        float sink = 0.0f;
+        const double calcNs = harness::NsPerStep(steps, [&] {
+            GImFontAsciiFastPath = fastPath;
+            for (int i = 0; i < 10; i++)
+                sink += font->CalcTextSizeA(13.0f, FLT_MAX, 0.0f, strings[i]).x;
+        });
+        const double renderNs = harness::NsPerStep(steps, [&] {
+            fast._ResetForNewFrame();
+            fast.PushTextureID(ImGui::GetIO().Fonts->TexID);
+            fast.PushClipRectFullScreen();
+            for (int i = 0; i < 10; i++)
+                fast.AddText(font, 13.0f, ImVec2(10.0f, 10.0f + i * 14.0f), IM_COL32_WHITE, strings[i]);
+        });
+        printf("  %-12s %14.0f %14.0f (%.0f)\n", fastPath ? "fast path" : "scalar", calcNs, renderNs, sink);
+    }
+
+    // Latin-1 labels stay on the scalar decoder, so this isolates the glyph lookup
+    const char* latin1[] = { "Gr\xc3\xb6\xc3\x9f" "e", "Schrift\xc3\xa4nderung", "F\xc3\xbcllfarbe", "\xc3\x9c" "bernehmen", "Men\xc3\xbc \xc3\x96" "ffnen" };
+    auto renderLatin1 = [&] {
+        fast._ResetForNewFrame();
+        fast.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        fast.PushClipRectFullScreen();
+        for (int i = 0; i < 10; i++)
+            fast.AddText(font, 13.0f, ImVec2(10.0f, 10.0f + i * 14.0f), IM_COL32_WHITE, i < 5 ? strings[i] : latin1[i - 5]);
+    };
+    double indexedNs = 0.0;
+    withoutHotGlyphs([&] { indexedNs = harness::NsPerStep(steps, renderLatin1); });
+    const double denseNs = harness::NsPerStep(steps, renderLatin1);
+    printf("  glyph lookup, mixed ASCII/Latin-1 render ns: IndexLookup %.0f, dense table %.0f (%d entries, %zu bytes)\n",
+        indexedNs, denseNs, font->HotGlyphs.Size, font->HotGlyphs.Size * sizeof(ImFontHotGlyph));
+    GImFontAsciiFastPath = true;
+    harness::DestroyContext();
+    return check.Result();
+}
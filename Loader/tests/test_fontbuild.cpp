@@ -0,0 +1,67 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "harness.h"
+#include "overlay/fontbuild.h"
+
+// Atlas build time against rasterization threads. The atlas holds the default font at every size the
+// overlay could ask for, oversampled, which is about what a CJK range costs. Every thread count has to
+// produce the same bitmap and glyphs as the serial build.
+int main()
+{
+    harness::Checks check("Font atlas build");
+
+    struct Built {
+        std::vector<unsigned char> pixels;
+        std::vector<ImFontGlyph> glyphs;
+        int width = 0, height = 0;
+        double ms = 0.0;
+    };
+    auto build = [](unsigned int threads) {
+        if (threads == 0)
+            fontbuild::DisableParallelRasterization();
+        else
+            fontbuild::EnableParallelRasterization(threads);
+
+        ImFontAtlas atlas;
+        for (float size : { 13.0f, 16.0f, 20.0f, 24.0f, 32.0f, 40.0f, 48.0f, 64.0f, 80.0f, 96.0f })
+        {
+            ImFontConfig cfg;
+            cfg.SizePixels = size;
+            cfg.OversampleH = 3;
+            cfg.OversampleV = 2;
+            cfg.RasterizerMultiply = size < 20.0f ? 1.2f : 1.0f;
+            atlas.AddFontDefault(&cfg);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        atlas.Build();
+        const auto end = std::chrono::steady_clock::now();
+
+        Built out;
+        out.ms = std::chrono::duration<double, std::milli>(end - start).count();
+        out.width = atlas.TexWidth;
+        out.height = atlas.TexHeight;
+        out.pixels.assign(atlas.TexPixelsAlpha8, atlas.TexPixelsAlpha8 + atlas.TexWidth * atlas.TexHeight);
+        for (ImFont* font : atlas.Fonts)
+            out.glyphs.insert(out.glyphs.end(), font->Glyphs.begin(), font->Glyphs.end());
+        return out;
+    };
+
+    const Built serial = build(0);
+    bool identical = true;
+    printf("  %-8s %10s   (%dx%d, %zu glyphs)\n", "threads", "ms", serial.width, serial.height, serial.glyphs.size());
+    printf("  %-8s %10.1f\n", "serial", serial.ms);
+    for (unsigned int threads : { 1u, 2u, 4u, 8u })
+    {
+        const Built parallel = build(threads);
+        identical = identical && parallel.width == serial.width && parallel.height == serial.height && parallel.pixels == serial.pixels
+            && parallel.glyphs.size() == serial.glyphs.size()
+            && memcmp(parallel.glyphs.data(), serial.glyphs.data(), serial.glyphs.size() * sizeof(ImFontGlyph)) == 0;
+        printf("  %-8u %10.1f\n", threads, parallel.ms);
+    }
+    fontbuild::DisableParallelRasterization();
+    check("atlas identical for every thread count", identical);
+    return check.Result();
+}
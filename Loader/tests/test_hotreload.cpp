@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+#include "harness.h"
+#include "overlay/overlay.h"
+#include "overlay/menu/configcatalog.h"
+#include "overlay/menu/configfile.h"
+#include "overlay/menu/configio.h"
+#include "overlay/menu/menu.h"
+
+// Hot reload: the field diff between the live config and a reloaded file, that only the sections it touches
+// invalidate their consumers, that unsaved menu edits survive a reload and that our own saves don't trigger
+// one. Needs the ImGui context.
+int main()
+{
+    harness::Checks check("Config hot reload");
+    harness::CreateContext();
+
+    Config live;
+    Config file = live;
+    check("identical configs: empty diff", configfile::Compare(live, file).Empty());
+
+    file.crosshair.size = live.crosshair.size + 5;
+    file.particles.particleSpeed = live.particles.particleSpeed * 2.0f;
+    const configfile::Diff diff = configfile::Compare(live, file);
+    check("diff: only the edited fields", diff.fields == ((1ull << (6 - 1)) | (1ull << (26 - 1))));
+    check("diff: crosshair and particles sections", diff.Has(ConfigSection::Crosshair) && diff.Has(ConfigSection::Particles) &&
+        !diff.Has(ConfigSection::Menu) && !diff.Has(ConfigSection::Aimbot) && !diff.Has(ConfigSection::Autoclicker));
+    configfile::ApplyDiff(live, file, diff);
+    check("apply: live matches the file", configfile::Compare(live, file).Empty());
+
+    // The overlay re-derives crosshair state only for crosshair edits
+    harness::StepFrame(false);
+    const unsigned int syncs = overlay::ConfigSyncCount;
+    MarkConfigDirty(ConfigSection::Particles);
+    harness::StepFrame(false);
+    check("particle edit doesn't re-sync the crosshair", overlay::ConfigSyncCount == syncs);
+    MarkConfigDirty(ConfigSection::Crosshair);
+    harness::StepFrame(false);
+    check("crosshair edit re-syncs once", overlay::ConfigSyncCount == syncs + 1);
+
+    // A reload applies what the file changed since we last read it, not everything that differs from the
+    // menu's config, which would revert edits that weren't saved yet
+    {
+        configio::ActiveFile active;
+        Config menu;
+        menu.crosshair.size = active.image.crosshair.size + 3;
+        Config external = active.image;
+        external.particles.particleSpeed = active.image.particles.particleSpeed * 2.0f;
+        configio::Completion reload;
+        reload.op = configio::Op::Reload;
+        reload.ok = true;
+        reload.config = std::make_unique<Config>(external);
+        const configfile::Diff applied = active.Reloaded(reload, menu);
+        check("reload keeps unsaved edits", menu.crosshair.size == active.image.crosshair.size + 3);
+        check("reload applies the file's changes", menu.particles.particleSpeed == external.particles.particleSpeed &&
+            applied.Has(ConfigSection::Particles) && !applied.Has(ConfigSection::Crosshair));
+    }
+
+    // Against a directory: the catalog may list our own save before its completion is polled, neither then
+    // nor after it may that queue a reload; a later write by someone else does
+    {
+        std::error_code ec;
+        const std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "oni-test-hotreload";
+        std::filesystem::remove_all(dir, ec);
+        std::filesystem::create_directories(dir, ec);
+
+        configio::Worker worker(dir.string());
+        configcatalog::Catalog catalog(dir.string());
+        catalog.useNotifications = false;
+        configio::ActiveFile active;
+        auto next = [&](configio::Completion& done) {
+            do {
+                while (!worker.Poll(done))
+                    std::this_thread::yield();
+            } while (done.op == configio::Op::Recover);
+        };
+        auto listed = [&]() -> const configcatalog::Entry* {
+            catalog.Invalidate();
+            const auto& list = catalog.Entries();
+            const int index = catalog.Find("hot");
+            return index < 0 ? nullptr : &list[index];
+        };
+
+        Config menu;
+        configfile::Save(worker.Path("hot"), menu);
+        configio::Completion done;
+        worker.Load("hot");
+        next(done);
+        active.Loaded(done);
+        check("loaded file isn't reloaded", done.ok && !active.Changed(listed()));
+
+        menu.crosshair.size = active.image.crosshair.size + 1;
+        active.Saving();
+        worker.Save("hot", menu);
+        while (worker.Pending() > 0)
+            std::this_thread::yield();
+        check("own save: no reload before its completion", !active.Changed(listed()));
+        next(done);
+        active.Saved(done);
+        check("own save: no reload after its completion", done.ok && active.savesInFlight == 0 && !active.Changed(listed()));
+
+        Config external = menu;
+        external.aimbot.x = menu.aimbot.x + 10;
+        configfile::Save(worker.Path("hot"), external);
+        std::filesystem::last_write_time(worker.Path("hot"), std::filesystem::last_write_time(worker.Path("hot"), ec) + std::chrono::seconds(2), ec);
+        check("external write: reload queued once", active.Changed(listed()) && !active.Changed(listed()));
+        worker.Reload("hot");
+        next(done);
+        menu.crosshair.thickness = active.image.crosshair.thickness + 1;
+        const configfile::Diff applied = done.ok ? active.Reloaded(done, menu) : configfile::Diff();
+        check("external write: only its field applied", applied.Has(ConfigSection::Aimbot) && !applied.Has(ConfigSection::Crosshair) &&
+            menu.aimbot.x == external.aimbot.x && menu.crosshair.thickness == external.crosshair.thickness + 1);
+        worker.Stop();
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    Config sink;
+    const double diffNs = harness::NsPerStep(100000, [&] { configfile::ApplyDiff(sink, file, configfile::Compare(sink, file)); sink = live; });
+    printf("  compare + apply: %.0f ns\n", diffNs);
+    harness::DestroyContext();
+    return check.Result();
+}
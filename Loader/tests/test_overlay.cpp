@@ -0,0 +1,51 @@
+#include <cstdio>
+
+#include "harness.h"
+#include "overlay/overlay.h"
+#include "overlay/menu/menu.h"
+
+// Config sync of overlay::draw_gui: frames without a config edit re-derive nothing, for every crosshair shape
+// with the menu closed and open, and one crosshair edit syncs exactly once. Frame timings are in overlay_bench.
+int main()
+{
+    harness::Checks check("Overlay config sync");
+    harness::CreateContext();
+
+    const int frames = 120;
+    bool unchangedNoSync = true;
+    for (int type = 0; type < static_cast<int>(crosshair::Shape::Count); type++)
+    {
+        for (int menuOpen = 0; menuOpen < 2; menuOpen++)
+        {
+            config->crosshair.enabled = true;
+            config->crosshair.type = type;
+            MarkConfigDirty();
+            // The first frame after the edit syncs, windows and buffers settle in the next few
+            for (int i = 0; i < 10; i++)
+                harness::StepFrame(menuOpen != 0);
+
+            const unsigned int syncs = overlay::ConfigSyncCount;
+            for (int i = 0; i < frames; i++)
+                harness::StepFrame(menuOpen != 0);
+            unchangedNoSync = unchangedNoSync && overlay::ConfigSyncCount == syncs;
+        }
+    }
+    check("unchanged frames: 0 config syncs", unchangedNoSync);
+
+    const unsigned int syncs = overlay::ConfigSyncCount;
+    config->crosshair.size++;
+    MarkConfigDirty(ConfigSection::Crosshair);
+    for (int i = 0; i < frames; i++)
+        harness::StepFrame(false);
+    check("one crosshair edit: 1 config sync", overlay::ConfigSyncCount - syncs == 1);
+
+    const unsigned int particleSyncs = overlay::ConfigSyncCount;
+    config->particles.particleSpeed *= 2.0f;
+    MarkConfigDirty(ConfigSection::Particles);
+    for (int i = 0; i < frames; i++)
+        harness::StepFrame(true);
+    check("particle edit: no crosshair sync", overlay::ConfigSyncCount == particleSyncs);
+
+    harness::DestroyContext();
+    return check.Result();
+}
@@ -0,0 +1,100 @@
+#include <cstdio>
+
+#include "harness.h"
+#include "overlay/overlay.h"
+#include "overlay/pacing.h"
+#include "overlay/menu/menu.h"
+
+// pacing::HashDrawData on the overlay's frames and on hand-built draw data, the FramePacer present/skip/idle
+// decisions, and the idle wait: no frame is built between wait slices, and it still ends after idleFrameMs.
+int main()
+{
+    harness::Checks check("Frame pacing");
+    harness::CreateContext();
+
+    // Static overlay frames hash the same, a crosshair edit doesn't
+    harness::StepFrame(false);
+    const uint64_t first = pacing::HashDrawData(ImGui::GetDrawData());
+    harness::StepFrame(false);
+    check("unchanged frame: same hash", pacing::HashDrawData(ImGui::GetDrawData()) == first);
+    const int savedSize = config->crosshair.size;
+    config->crosshair.size = savedSize + 4;
+    MarkConfigDirty(ConfigSection::Crosshair);
+    harness::StepFrame(false);
+    check("crosshair edit: new hash", pacing::HashDrawData(ImGui::GetDrawData()) != first);
+    config->crosshair.size = savedSize;
+    MarkConfigDirty(ConfigSection::Crosshair);
+    harness::StepFrame(false);
+    check("edit undone: hash back", pacing::HashDrawData(ImGui::GetDrawData()) == first);
+
+    // Hand-built: what changes the image has to change the hash, even with identical vertices
+    ImDrawList list(ImGui::GetDrawListSharedData());
+    ImDrawData data;
+    auto build = [&](float clipRight, ImTextureID tex, ImU32 col) -> uint64_t {
+        list._ResetForNewFrame();
+        list.PushTextureID(tex);
+        list.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(clipRight, 480.0f));
+        list.AddRectFilled(ImVec2(10.0f, 10.0f), ImVec2(90.0f, 50.0f), col);
+        list._PopUnusedDrawCmd();
+        data.Clear();
+        data.Valid = true;
+        data.DisplaySize = ImVec2(640.0f, 480.0f);
+        data.CmdLists.push_back(&list);
+        data.CmdListsCount = 1;
+        data.TotalVtxCount = list.VtxBuffer.Size;
+        data.TotalIdxCount = list.IdxBuffer.Size;
+        return pacing::HashDrawData(&data);
+    };
+    const ImTextureID font = ImGui::GetIO().Fonts->TexID;
+    const uint64_t base = build(640.0f, font, IM_COL32_WHITE);
+    check("hand-built: deterministic", build(640.0f, font, IM_COL32_WHITE) == base);
+    check("hand-built: vertex color", build(640.0f, font, IM_COL32(255, 255, 255, 254)) != base);
+    check("hand-built: clip rect", build(50.0f, font, IM_COL32_WHITE) != base);
+    check("hand-built: texture", build(640.0f, (ImTextureID)(intptr_t)1, IM_COL32_WHITE) != base);
+    build(640.0f, font, IM_COL32_WHITE);
+    data.DisplaySize = ImVec2(800.0f, 600.0f);
+    check("hand-built: display size", pacing::HashDrawData(&data) != base);
+    data.Valid = false;
+    check("invalid draw data: fixed hash", pacing::HashDrawData(&data) == pacing::HashDrawData(nullptr));
+
+    // Present, skip, idle
+    pacing::FramePacer pacer;
+    build(640.0f, font, IM_COL32_WHITE);
+    const bool presented = pacer.ShouldPresent(&data, false, false);
+    const bool skipped = !pacer.ShouldPresent(&data, false, false);
+    const bool idleEarly = pacer.IsIdle();
+    const bool skippedAgain = !pacer.ShouldPresent(&data, false, false);
+    check("first frame presented, repeats skipped", presented && skipped && skippedAgain && pacer.framesPresented == 1 && pacer.framesSkipped == 2);
+    check("idle after idleAfterFrames repeats", !idleEarly && pacer.IsIdle());
+    check("forced frame presented, not idle", pacer.ShouldPresent(&data, false, true) && !pacer.IsIdle());
+    check("animating frames always presented", pacer.ShouldPresent(&data, true, false) && pacer.ShouldPresent(&data, true, false) && !pacer.IsIdle());
+    check("static frame after animation presented once", pacer.ShouldPresent(&data, false, false) && !pacer.ShouldPresent(&data, false, false));
+    build(640.0f, font, IM_COL32_BLACK);
+    check("changed frame presented", pacer.ShouldPresent(&data, false, false) && !pacer.IsIdle());
+
+    // Idle wait: slices until idleFrameMs without building a frame, woken early by input or the poll
+    pacer.policy.idleWaitMs = 20;
+    pacer.policy.idleFrameMs = 500;
+    int waits = 0, polls = 0;
+    auto wait = [&](unsigned int) { waits++; return false; };
+    auto poll = [&] { polls++; return false; };
+    check("not idle: no wait", !pacer.WaitIdle(wait, poll) && waits == 0);
+    for (int i = 0; i < pacer.policy.idleAfterFrames; i++) pacer.ShouldPresent(&data, false, false);
+    const uint64_t slicesBefore = pacer.idleSlices;
+    const bool woken = pacer.WaitIdle(wait, poll);
+    check("idle: waits idleFrameMs in slices", !woken && waits == 25 && polls == 25 && pacer.idleSlices - slicesBefore == 25);
+    waits = 0;
+    check("idle: input ends the wait", pacer.WaitIdle([&](unsigned int) { return ++waits == 3; }, poll) && waits == 3);
+    waits = 0;
+    check("idle: menu key poll ends the wait", pacer.WaitIdle(wait, [&] { return waits == 2; }) && waits == 2);
+
+    // What an idle slice saves: before, every idleWaitMs ran a whole frame (NewFrame, overlay, Render, hash)
+    const double frameNs = harness::NsPerStep(2000, [&] {
+        harness::StepFrame(false);
+        pacer.ShouldPresent(ImGui::GetDrawData(), false, false);
+    });
+    printf("  idle frame: %.0f ns, at 20 ms per frame %.2f%% of a core; now one per %u ms\n", frameNs, frameNs / 20e6 * 100.0, pacer.policy.idleFrameMs);
+
+    harness::DestroyContext();
+    return check.Result();
+}
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "harness.h"
+#include "overlay/menu/particles.h"
+
+// Seeded store with particles parked on the edges: about to pass the left or right wrap line, or to fall
+// past the respawn line, so the first frames exercise every branch of the integrate step
+static particles::ParticleStore EdgeStore(size_t count, const ImVec2& area)
+{
+    particles::SeedRng(0x5EED);
+    particles::ParticleStore store;
+    particles::Spawn(store, count, area, particles::SpawnParams());
+    for (size_t i = 0; i < count; i++)
+    {
+        switch (i % 5)
+        {
+        case 0: store.x[i] = -39.95f; store.vx[i] = -4.0f; break;
+        case 1: store.x[i] = area.x + 39.95f; store.vx[i] = 4.0f; break;
+        case 2: store.y[i] = area.y + 19.9f; break;
+        case 3: store.x[i] = -39.99f; store.vx[i] = -3.5f; store.y[i] = area.y + 19.95f; break;
+        default: break;
+        }
+    }
+    return store;
+}
+
+// Positions may differ by rounding if the compiler contracts the scalar x + vx * dt into an FMA
+static bool SameStore(const particles::ParticleStore& a, const particles::ParticleStore& b)
+{
+    if (a.Count() != b.Count())
+        return false;
+    for (size_t i = 0; i < a.Count(); i++)
+    {
+        if (std::fabs(a.x[i] - b.x[i]) > 1e-3f || std::fabs(a.y[i] - b.y[i]) > 1e-3f)
+            return false;
+        if (a.vx[i] != b.vx[i] || a.vy[i] != b.vy[i] || a.size[i] != b.size[i] || a.alpha[i] != b.alpha[i])
+            return false;
+    }
+    return true;
+}
+
+// Integrate() (the SSE2 or AVX2 loop plus its scalar tail) against IntegrateScalar(), from the same seeded
+// store and the same generator state, at counts that leave a tail for either vector width. Then Draw()'s
+// sprite path against the circle fallback, before and after an atlas rebuild.
+int main()
+{
+    harness::Checks check("Particles");
+    const ImVec2 area(660.0f, 480.0f);
+    const float deltaTime = 1.0f / 60.0f;
+#if defined(__AVX2__)
+    printf("  Integrate runs the AVX2 loop (8 wide)\n");
+#else
+    printf("  Integrate runs the SSE2 loop (4 wide)\n");
+#endif
+
+    bool firstFrame = true, manyFrames = true, edgesCrossed = true;
+    for (size_t count : { static_cast<size_t>(1), static_cast<size_t>(3), static_cast<size_t>(7), static_cast<size_t>(13),
+        static_cast<size_t>(501), static_cast<size_t>(particles::kMaxCount) - 3 })
+    {
+        particles::ParticleStore simd = EdgeStore(count, area);
+        particles::ParticleStore scalar = simd;
+        const particles::ParticleStore before = simd;
+
+        particles::SeedRng(count);
+        particles::Integrate(simd, deltaTime, area);
+        particles::SeedRng(count);
+        particles::IntegrateScalar(scalar, deltaTime, area);
+        firstFrame = firstFrame && SameStore(simd, scalar);
+
+        // Left wraps to the right edge, right wraps to the left edge, the fallers come back above the area
+        for (size_t i = 0; i < count && i < 5; i++)
+        {
+            if (i == 0) edgesCrossed = edgesCrossed && simd.x[i] == area.x + 40.0f;
+            if (i == 1) edgesCrossed = edgesCrossed && simd.x[i] == -40.0f;
+            if (i >= 2 && i <= 3) edgesCrossed = edgesCrossed && simd.y[i] < 0.0f && simd.y[i] != before.y[i];
+        }
+
+        // 120 long frames, compared after each one; every particle falls through the bottom at least once
+        for (int frame = 0; frame < 120 && manyFrames; frame++)
+        {
+            particles::SeedRng(count * 1000 + frame);
+            particles::Integrate(simd, deltaTime * 8.0f, area);
+            particles::SeedRng(count * 1000 + frame);
+            particles::IntegrateScalar(scalar, deltaTime * 8.0f, area);
+            manyFrames = SameStore(simd, scalar);
+        }
+    }
+    check("first frame matches IntegrateScalar", firstFrame);
+    check("wrap and respawn edges crossed", edgesCrossed);
+    check("120 frames match IntegrateScalar", manyFrames);
+
+    // Draw: one sprite quad per particle while the atlas holds the sprite, circles once a rebuild wiped it
+    harness::CreateContext();
+    particles::SeedRng(1);
+    particles::ParticleStore store;
+    const int count = 100;
+    particles::Spawn(store, count, area, particles::SpawnParams());
+    ImDrawList dl(ImGui::GetDrawListSharedData());
+    auto emit = [&](bool sprite) {
+        dl._ResetForNewFrame();
+        dl.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        dl.PushClipRectFullScreen();
+        if (sprite)
+            particles::Draw(&dl, store, ImVec2(0.0f, 0.0f), area);
+        else
+            particles::DrawCircles(&dl, store, ImVec2(0.0f, 0.0f), area);
+        return dl.VtxBuffer.Size;
+    };
+    const int spriteVtx = emit(true);
+    const int spriteIdx = dl.IdxBuffer.Size;
+    const int circleVtx = emit(false);
+    check("sprite path: 4 vertices a particle", spriteVtx == count * 4 && spriteIdx == count * 6);
+    check("circle path emits more vertices", circleVtx > spriteVtx);
+
+    ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+    fonts->ClearTexData();
+    fonts->Build();
+    check("atlas rebuild falls back to circles", emit(true) == circleVtx);
+    particles::BakeSprite(fonts);
+    check("baking again restores the sprite", emit(true) == spriteVtx);
+    harness::DestroyContext();
+    return check.Result();
+}
@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "harness.h"
+#include "overlay/profiler.h"
+
+static std::string ReadFile(const std::string& path)
+{
+    std::ifstream ifs(path);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+// Records frames first..last-1; frame i has MessagePump = i + 1 ns and drawCallsSaved = i % 4
+static void RecordFrames(int first, int last)
+{
+    for (int i = first; i < last; i++)
+    {
+        profiler::BeginFrame();
+        profiler::AddStageTime(profiler::Stage::MessagePump, static_cast<uint64_t>(i + 1));
+        profiler::AddDrawCallsSaved(i % 4);
+        profiler::EndFrame(nullptr, i % 2 == 0);
+    }
+}
+
+// Profiler ring, percentiles and dumps on a known sample set: frames are fed through the
+// render-loop API (single thread, like load()), so the stage times are the test's own numbers.
+int main()
+{
+    harness::Checks check("Profiler");
+    using profiler::kHistorySize;
+    std::vector<profiler::FrameSample> history(kHistorySize + 8);
+
+    // Before the ring fills, CopyHistory hands back what there is, oldest first
+    RecordFrames(0, 3);
+    int copied = profiler::CopyHistory(history.data(), 10);
+    check("partial ring copies 3 frames", copied == 3 && history[0].frameIndex == 0 && history[2].frameIndex == 2);
+    copied = profiler::CopyHistory(history.data(), 2);
+    check("maxCount keeps the most recent", copied == 2 && history[0].frameIndex == 1 && history[1].frameIndex == 2);
+
+    // Past capacity the ring keeps the last kHistorySize frames, in order, across the wrap
+    const int total = kHistorySize + 88;
+    RecordFrames(3, total);
+    copied = profiler::CopyHistory(history.data(), static_cast<int>(history.size()));
+    bool ordered = copied == kHistorySize;
+    for (int i = 0; ordered && i < copied; i++)
+    {
+        const uint64_t frame = static_cast<uint64_t>(total - kHistorySize + i);
+        ordered = history[i].frameIndex == frame && history[i].stageNs[0] == frame + 1 && history[i].drawCallsSaved == static_cast<int>(frame % 4);
+    }
+    check("ring wraps to the last 512, oldest first", ordered);
+
+    // MessagePump over the ring is 89..600: p50 = sorted[256], p99 = sorted[506]
+    const profiler::Summary summary = profiler::Summarize();
+    const profiler::Percentiles& pump = summary.stage[static_cast<int>(profiler::Stage::MessagePump)];
+    check("summary covers the whole ring", summary.frames == kHistorySize);
+    check("percentiles of 89..600", pump.p50 == 345 && pump.p99 == 595 && pump.max == 600);
+    check("percentiles of i % 4", summary.drawCallsSaved.p50 == 2 && summary.drawCallsSaved.p99 == 3 && summary.drawCallsSaved.max == 3);
+    check("no draw data records zero counts", summary.vtxCount.max == 0 && summary.drawCalls.max == 0);
+
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "oni-test-profiler";
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+
+    // CSV: header, then one row per frame with every stage column
+    const std::string csvPath = (dir / "profile.csv").string();
+    std::string header = "frame,frame_ns";
+    for (const char* name : profiler::kStageNames)
+        header += std::string(",") + name + "_ns";
+    header += ",vertices,indices,draw_calls,draw_calls_saved,presented";
+    std::vector<std::string> rows;
+    if (profiler::DumpCsv(csvPath.c_str()))
+    {
+        std::istringstream csv(ReadFile(csvPath));
+        for (std::string line; std::getline(csv, line); )
+            rows.push_back(line);
+    }
+    check("csv header", !rows.empty() && rows[0] == header);
+    check("csv has one row per frame", rows.size() == static_cast<size_t>(kHistorySize + 1));
+    bool rowsMatch = rows.size() == static_cast<size_t>(kHistorySize + 1);
+    for (int i = 0; rowsMatch && i < kHistorySize; i++)
+    {
+        std::vector<std::string> fields;
+        std::istringstream row(rows[i + 1]);
+        for (std::string field; std::getline(row, field, ','); )
+            fields.push_back(field);
+        const uint64_t frame = static_cast<uint64_t>(total - kHistorySize + i);
+        rowsMatch = fields.size() == static_cast<size_t>(profiler::kStageCount + 7) && fields[0] == std::to_string(frame)
+            && fields[2] == std::to_string(frame + 1) && fields[profiler::kStageCount + 5] == std::to_string(frame % 4)
+            && fields[profiler::kStageCount + 6] == (frame % 2 == 0 ? "1" : "0");
+    }
+    check("csv rows carry the recorded samples", rowsMatch);
+
+    // JSON: summary object with the same percentiles, then the frames array
+    const std::string jsonPath = (dir / "profile.json").string();
+    const std::string json = profiler::DumpJson(jsonPath.c_str()) ? ReadFile(jsonPath) : std::string();
+    size_t frameEntries = 0;
+    for (size_t at = json.find("{ \"frame\": "); at != std::string::npos; at = json.find("{ \"frame\": ", at + 1))
+        frameEntries++;
+    const std::string lastFrame = "{ \"frame\": " + std::to_string(total - 1) + ", \"frame_ns\": ";
+    check("json summary then frames", json.rfind("{\n  \"summary\": {\n", 0) == 0 && json.find("  },\n  \"frames\": [\n") != std::string::npos &&
+        json.size() >= 6 && json.compare(json.size() - 6, 6, "  ]\n}\n") == 0);
+    check("json summary percentiles", json.find("\"MessagePump\": { \"p50\": 345, \"p99\": 595, \"max\": 600 },") != std::string::npos &&
+        json.find("\"draw_calls_saved\": { \"p50\": 2, \"p99\": 3, \"max\": 3 }\n") != std::string::npos);
+    check("json has one entry per frame", frameEntries == static_cast<size_t>(kHistorySize) && json.find(lastFrame) != std::string::npos);
+    check("json frame fields", json.find("\"stages_ns\": [" + std::to_string(total) + ", 0, 0, 0, 0, 0, 0], \"vertices\": 0, \"indices\": 0, \"draw_calls\": 0, \"draw_calls_saved\": "
+        + std::to_string((total - 1) % 4) + ", \"presented\": false }\n") != std::string::npos);
+    std::filesystem::remove_all(dir, ec);
+
+    check("dump into a missing directory fails", !profiler::DumpCsv((dir / "missing" / "x.csv").string().c_str()));
+    return check.Result();
+}
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cstdio>
+
+#include "harness.h"
+#include "overlay/overlay.h"
+#include "overlay/fontbuild.h"
+
+#include <imgui_impl_soft.h>
+
+// imgui_impl_soft against RasterizeReference, which serves as the golden image: every crosshair shape with the
+// menu closed, the menu with its particles open, and a display size that isn't a multiple of the tile or group
+// size. Tiles drawn on worker threads have to give the same image.
+int main()
+{
+    harness::Checks check("Software rasterizer (imgui_impl_soft)");
+    harness::CreateContext();
+
+    printf("  %-26s %9s %12s %12s %12s\n", "frame", "triangles", "reference ms", "1 thread ms", "threads ms");
+
+    ImGui_ImplSoft_Init();
+    ImGui_ImplSoft_NewFrame();
+    fontbuild::EnableParallelRasterization();
+    const unsigned int threads = fontbuild::RasterizationThreads();
+
+    harness::Image reference, serial, parallel;
+    // Clearing is part of the render: the image starts out as garbage
+    auto msPerRender = [&](ImDrawData* drawData, harness::Image& image, bool threaded) {
+        image.width = static_cast<int>(drawData->DisplaySize.x);
+        image.height = static_cast<int>(drawData->DisplaySize.y);
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0xDEADBEEFu);
+        ImGui_ImplSoft_Target target = { image.pixels.data(), image.width, image.height, image.width, true };
+        ImGui_ImplSoft_SetParallelFor(threaded ? GImFontAtlasParallelFor : nullptr);
+
+        const int runs = 3;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < runs; i++)
+            ImGui_ImplSoft_RenderDrawData(drawData, &target);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / runs;
+    };
+
+    bool crosshairsMatch = true, menuMatches = true, oddMatches = true, threadsMatch = true;
+    double serialMs = 0.0, parallelMs = 0.0;
+    auto compare = [&](const char* name, bool* matches) {
+        ImDrawData* drawData = ImGui::GetDrawData();
+        const auto start = std::chrono::steady_clock::now();
+        harness::RasterizeReference(drawData, reference);
+        const double referenceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        serialMs = msPerRender(drawData, serial, false);
+        parallelMs = msPerRender(drawData, parallel, true);
+        *matches = *matches && serial.pixels == reference.pixels;
+        threadsMatch = threadsMatch && parallel.pixels == serial.pixels;
+
+        int triangles = 0;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+            triangles += drawData->CmdLists[n]->IdxBuffer.Size / 3;
+        printf("  %-26s %9d %12.2f %12.3f %12.3f\n", name, triangles, referenceMs, serialMs, parallelMs);
+    };
+
+    config->crosshair.enabled = true;
+    for (int type = 0; type < static_cast<int>(crosshair::Shape::Count); type++)
+    {
+        config->crosshair.type = type;
+        MarkConfigDirty();
+        for (int i = 0; i < 3; i++)
+            harness::StepFrame(false);
+        compare(crosshair::kShapeNames[type], &crosshairsMatch);
+    }
+    for (int i = 0; i < 3; i++)
+        harness::StepFrame(true);
+    compare("menu + particles", &menuMatches);
+    const double menuMs = serialMs, menuThreadedMs = parallelMs;
+
+    ImGuiIO& io = ImGui::GetIO();
+    const ImVec2 displaySize = io.DisplaySize;
+    io.DisplaySize = ImVec2(1001.0f, 601.0f);
+    for (int i = 0; i < 3; i++)
+        harness::StepFrame(true);
+    compare("menu at 1001x601", &oddMatches);
+    io.DisplaySize = displaySize;
+    harness::StepFrame(false);
+
+    fontbuild::DisableParallelRasterization();
+    ImGui_ImplSoft_Shutdown();
+    printf("  menu frame: %.0f fps on 1 thread, %.0f fps on %u threads\n", 1000.0 / menuMs, 1000.0 / menuThreadedMs, threads);
+    check("crosshair frames match the reference", crosshairsMatch);
+    check("menu frame matches the reference", menuMatches);
+    check("odd display size matches the reference", oddMatches);
+    check("threaded tiles match one thread", threadsMatch);
+    harness::DestroyContext();
+    return check.Result();
+}
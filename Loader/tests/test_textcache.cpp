@@ -0,0 +1,153 @@
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "harness.h"
+#include "overlay/textcache.h"
+
+// Same vertices/indices as AddText, apart from float rounding of the pen position
+static bool SameGeometry(const ImDrawList& a, const ImDrawList& b)
+{
+    if (a.VtxBuffer.Size != b.VtxBuffer.Size || a.IdxBuffer.Size != b.IdxBuffer.Size) return false;
+    for (int i = 0; i < a.VtxBuffer.Size; i++)
+    {
+        const ImDrawVert& va = a.VtxBuffer[i];
+        const ImDrawVert& vb = b.VtxBuffer[i];
+        if (fabsf(va.pos.x - vb.pos.x) > 0.01f || fabsf(va.pos.y - vb.pos.y) > 0.01f) return false;
+        if (va.uv.x != vb.uv.x || va.uv.y != vb.uv.y || va.col != vb.col) return false;
+    }
+    return memcmp(a.IdxBuffer.Data, b.IdxBuffer.Data, a.IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+}
+
+// Overlay labels through AddText and through the shaped-text cache.
+int main()
+{
+    harness::Checks check("Overlay text");
+    harness::CreateContext();
+
+    ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    const ImU32 col = IM_COL32(255, 200, 40, 255);
+    ImDrawList addText(ImGui::GetDrawListSharedData());
+    ImDrawList cached(ImGui::GetDrawListSharedData());
+    auto reset = [](ImDrawList& dl) {
+        dl._ResetForNewFrame();
+        dl.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        dl.PushClipRectFullScreen();
+    };
+
+    const char* labels[] = { "OniV2", "Aimbot", "Autoclicker [12-16 cps]", "Crosshair: Windmill1954", "two\nlines" };
+    bool same = true, sized = true;
+    for (const char* text : labels)
+    {
+        for (float size : { 13.0f, 20.0f, 27.5f })
+        {
+            reset(addText);
+            reset(cached);
+            addText.AddText(font, size, ImVec2(101.7f, 33.2f), col, text);
+            textcache::Run run;
+            textcache::Shape(run, font, size, text);
+            textcache::Blit(&cached, run, ImVec2(101.7f, 33.2f), col);
+            same = same && SameGeometry(addText, cached);
+            const ImVec2 measured = font->CalcTextSizeA(size, FLT_MAX, 0.0f, text);
+            sized = sized && fabsf(measured.x - run.Size.x) < 0.01f && measured.y == run.Size.y;
+        }
+    }
+    check("blit matches AddText", same);
+    check("run size matches CalcTextSizeA", sized);
+
+    textcache::Cache cache;
+    cache.Get(font, 20.0f, "OniV2");
+    cache.Get(font, 20.0f, "OniV2");
+    cache.Get(font, 14.0f, "OniV2");
+    check("repeated text is shaped once", cache.shapes == 2 && cache.hits == 1 && cache.Size() == 2);
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    const ImTextureID texId = atlas->TexID;
+    atlas->SetTexID(reinterpret_cast<ImTextureID>(static_cast<intptr_t>(0x5EED)));
+    cache.Get(font, 20.0f, "OniV2");
+    atlas->SetTexID(texId);
+    check("atlas change reshapes", cache.shapes == 3);
+    for (unsigned int i = 0; i < textcache::Cache::kMaxIdleFrames; i++)
+        cache.NewFrame();
+    check("idle entries evicted", cache.Size() == 0 && cache.evictions == 2);
+
+    textcache::NumberLabel label;
+    textcache::SetNumber(label, font, 13.0f, "OniV2 | FPS: ", 144);
+    const unsigned int afterFirst = label.DigitsShaped;
+    textcache::SetNumber(label, font, 13.0f, "OniV2 | FPS: ", 144);
+    const bool unchanged = label.DigitsShaped == afterFirst;
+    textcache::SetNumber(label, font, 13.0f, "OniV2 | FPS: ", 145);
+    const bool lastDigit = label.DigitsShaped == afterFirst + 1;
+    textcache::Run expected;
+    textcache::Shape(expected, font, 13.0f, "OniV2 | FPS: 145");
+    reset(addText);
+    reset(cached);
+    textcache::Blit(&addText, expected, ImVec2(10.0f, 10.0f), col);
+    textcache::Blit(&cached, label.Out, ImVec2(10.0f, 10.0f), col);
+    check("FPS label re-lays only changed digits", unchanged && lastDigit && label.Rebuilds == 1);
+    check("FPS label matches a full shape", SameGeometry(addText, cached) && fabsf(expected.Size.x - label.Out.Size.x) < 0.01f);
+
+    std::vector<std::string> features = { "Aimbot", "Autoclicker [12-16 cps]", "Crosshair", "Particles", "Triggerbot", "ESP" };
+    textcache::Block block;
+    bool batched = textcache::Update(block, font, 16.0f, features) && block.Runs.size() == features.size();
+    for (size_t i = 0; batched && i < features.size(); i++)
+    {
+        textcache::Run single;
+        textcache::Shape(single, font, 16.0f, features[i].c_str());
+        reset(addText);
+        reset(cached);
+        textcache::Blit(&addText, single, ImVec2(0.0f, 0.0f), col);
+        textcache::Blit(&cached, block.Runs[i], ImVec2(0.0f, 0.0f), col);
+        const ImVec2 measured = font->CalcTextSizeA(16.0f, FLT_MAX, 0.0f, features[i].c_str());
+        batched = SameGeometry(addText, cached) && fabsf(block.Runs[i].Size.x - measured.x) < 0.01f;
+    }
+    check("batched layout matches per-string shape", batched);
+    const bool kept = !textcache::Update(block, font, 16.0f, features);
+    features[1] = "Autoclicker [8-12 cps]";
+    check("feature list re-laid out only on change", kept && textcache::Update(block, font, 16.0f, features) && block.Layouts == 2);
+
+    // One frame of the overlay labels: watermark plus a right-aligned feature list
+    const int steps = 20000;
+    printf("  %-12s %10s %10s\n", "path", "ns/frame", "vtx");
+    auto measure = [&](const char* name, ImDrawList& dl, auto&& emit) {
+        const double ns = harness::NsPerStep(steps, [&] { reset(dl); emit(dl); });
+        printf("  %-12s %10.0f %10d\n", name, ns, dl.VtxBuffer.Size);
+    };
+    measure("AddText", addText, [&](ImDrawList& dl) {
+        dl.AddText(font, 20.0f, ImVec2(40.0f, 1000.0f), col, "OniV2");
+        float y = 40.0f;
+        for (const std::string& f : features)
+        {
+            const ImVec2 size = font->CalcTextSizeA(16.0f, FLT_MAX, 0.0f, f.c_str(), f.c_str() + f.size());
+            dl.AddText(font, 16.0f, ImVec2(1880.0f - size.x, y), col, f.c_str(), f.c_str() + f.size());
+            y += 22.0f;
+        }
+    });
+    measure("cached", cached, [&](ImDrawList& dl) {
+        textcache::Blit(&dl, cache.Get(font, 20.0f, "OniV2"), ImVec2(40.0f, 1000.0f), col);
+        textcache::Update(block, font, 16.0f, features);
+        float y = 40.0f;
+        for (const textcache::Run& run : block.Runs)
+        {
+            textcache::Blit(&dl, run, ImVec2(1880.0f - run.Size.x, y), col);
+            y += 22.0f;
+        }
+    });
+
+    int fps = 0;
+    measure("FPS AddText", addText, [&](ImDrawList& dl) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "OniV2 | FPS: %.0f", 140.0f + (fps++ / 30) % 20);
+        const ImVec2 size = font->CalcTextSizeA(13.0f, FLT_MAX, 0.0f, buffer);
+        dl.AddText(font, 13.0f, ImVec2(1900.0f - size.x, 10.0f), col, buffer);
+    });
+    fps = 0;
+    measure("FPS label", cached, [&](ImDrawList& dl) {
+        textcache::SetNumber(label, font, 13.0f, "OniV2 | FPS: ", 140 + (fps++ / 30) % 20);
+        textcache::Blit(&dl, label.Out, ImVec2(1900.0f - label.Out.Size.x, 10.0f), col);
+    });
+    harness::DestroyContext();
+    return check.Result();
+}
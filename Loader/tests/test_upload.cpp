@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "harness.h"
+
+#include <imgui_impl_upload.h>
+
+// ImUploadPlanner (imgui_impl_upload.h) over an overlay-like frame sequence: a static background list (crosshair,
+// watermark), a foreground label that changes once a second, particles that change every frame and a menu that
+// opens with three windows, one of them growing. The GPU buffers are emulated: each frame the plan is carried out
+// on them, then every list has to read back its own data and, unless the plan discarded, nothing the previous
+// frame drew from may have been written.
+int main()
+{
+    harness::Checks check("Draw data uploads");
+
+    std::mt19937 gen(7);
+    auto fill = [&](ImDrawList& dl, int vtxCount, int idxCount) {
+        dl.VtxBuffer.resize(vtxCount);
+        dl.IdxBuffer.resize(idxCount);
+        for (ImDrawVert& v : dl.VtxBuffer)
+        {
+            v.pos = ImVec2(static_cast<float>(gen() % 1920), static_cast<float>(gen() % 1080));
+            v.uv = ImVec2(0.5f, 0.5f);
+            v.col = gen();
+        }
+        for (ImDrawIdx& i : dl.IdxBuffer)
+            i = static_cast<ImDrawIdx>(gen() % vtxCount);
+    };
+
+    ImDrawList background(nullptr), foreground(nullptr), particles(nullptr);
+    ImDrawList windows[3] = { nullptr, nullptr, nullptr };
+    fill(background, 1200, 1800);
+    fill(windows[2], 1500, 2250);
+
+    ImUploadPlanner planner;
+    ImUploadPlan plan;
+    ImDrawData data;
+    std::vector<ImDrawVert> gpuVtx;
+    std::vector<ImDrawIdx> gpuIdx;
+    const ImDrawVert garbage = { ImVec2(-1.0f, -1.0f), ImVec2(-1.0f, -1.0f), 0xDEADBEEF };
+
+    struct Placed { int vtxBegin, vtxEnd, idxBegin, idxEnd; };
+    std::vector<Placed> lastFrame;
+    auto build = [&](std::initializer_list<ImDrawList*> lists) {
+        data.Clear();
+        for (ImDrawList* dl : lists)
+        {
+            data.CmdLists.push_back(dl);
+            data.CmdListsCount++;
+            data.TotalVtxCount += dl->VtxBuffer.Size;
+            data.TotalIdxCount += dl->IdxBuffer.Size;
+        }
+    };
+
+    // Carries out the plan on the emulated buffers and checks it
+    bool placedCorrectly = true, inFlightUntouched = true;
+    uint64_t fullCopyBytes = 0;
+    double planNs = 0.0;
+    int frames = 0, backgroundReused = 0, oldSchemeReallocs = 0;
+    int oldVtxSize = 0, oldIdxSize = 0;
+    auto frame = [&] {
+        const auto start = std::chrono::steady_clock::now();
+        planner.Plan(&data, &plan);
+        planNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        frames++;
+        fullCopyBytes += static_cast<uint64_t>(data.TotalVtxCount) * sizeof(ImDrawVert) + static_cast<uint64_t>(data.TotalIdxCount) * sizeof(ImDrawIdx);
+        // What the backend did before: recreate whichever buffer is too small with 5000/10000 elements to spare
+        const bool oldVtxRealloc = oldVtxSize == 0 || oldVtxSize < data.TotalVtxCount;
+        const bool oldIdxRealloc = oldIdxSize == 0 || oldIdxSize < data.TotalIdxCount;
+        if (oldVtxRealloc) oldVtxSize = data.TotalVtxCount + 5000;
+        if (oldIdxRealloc) oldIdxSize = data.TotalIdxCount + 10000;
+        oldSchemeReallocs += (oldVtxRealloc || oldIdxRealloc) ? 1 : 0;
+
+        if (plan.Recreate)
+        {
+            gpuVtx.assign(plan.VtxCapacity, garbage);
+            gpuIdx.assign(plan.IdxCapacity, static_cast<ImDrawIdx>(0xFFFF));
+        }
+        else if (plan.Discard)
+        {
+            std::fill(gpuVtx.begin(), gpuVtx.end(), garbage);
+            std::fill(gpuIdx.begin(), gpuIdx.end(), static_cast<ImDrawIdx>(0xFFFF));
+        }
+        else
+        {
+            for (const Placed& p : lastFrame)
+                if ((p.vtxBegin < plan.VtxWriteEnd && plan.VtxWriteBegin < p.vtxEnd) || (p.idxBegin < plan.IdxWriteEnd && plan.IdxWriteBegin < p.idxEnd))
+                    inFlightUntouched = false;
+        }
+
+        lastFrame.clear();
+        for (int n = 0; n < data.CmdListsCount; n++)
+        {
+            const ImDrawList* dl = data.CmdLists[n];
+            const ImUploadPlacement& p = plan.Lists[n];
+            const Placed placed = { p.VtxOffset, p.VtxOffset + dl->VtxBuffer.Size, p.IdxOffset, p.IdxOffset + dl->IdxBuffer.Size };
+            if (placed.vtxEnd > plan.VtxCapacity || placed.idxEnd > plan.IdxCapacity)
+            {
+                placedCorrectly = false;
+                continue;
+            }
+            if (p.Upload)
+            {
+                if (placed.vtxBegin < plan.VtxWriteBegin || placed.vtxEnd > plan.VtxWriteEnd || placed.idxBegin < plan.IdxWriteBegin || placed.idxEnd > plan.IdxWriteEnd)
+                    placedCorrectly = false;
+                memcpy(gpuVtx.data() + placed.vtxBegin, dl->VtxBuffer.Data, dl->VtxBuffer.Size * sizeof(ImDrawVert));
+                memcpy(gpuIdx.data() + placed.idxBegin, dl->IdxBuffer.Data, dl->IdxBuffer.Size * sizeof(ImDrawIdx));
+            }
+            else if (dl == &background)
+            {
+                backgroundReused++;
+            }
+            lastFrame.push_back(placed);
+        }
+        for (int n = 0; n < data.CmdListsCount; n++)
+        {
+            const ImDrawList* dl = data.CmdLists[n];
+            const Placed& placed = lastFrame[n];
+            placedCorrectly = placedCorrectly
+                && memcmp(gpuVtx.data() + placed.vtxBegin, dl->VtxBuffer.Data, dl->VtxBuffer.Size * sizeof(ImDrawVert)) == 0
+                && memcmp(gpuIdx.data() + placed.idxBegin, dl->IdxBuffer.Data, dl->IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+        }
+    };
+
+    for (int i = 0; i < 600; i++)
+    {
+        if (i % 60 == 0)
+            fill(foreground, 200, 300);
+        fill(particles, 400 + (i % 50) * 8, 600 + (i % 50) * 12);
+        if (i >= 200 && i < 450)
+        {
+            if ((i - 200) % 45 == 0)
+                fill(windows[0], 3000, 4500);
+            if ((i - 200) % 10 == 0)
+                fill(windows[1], 2000 + (i - 200) * 40, 3000 + (i - 200) * 60);
+            build({ &background, &windows[0], &windows[1], &windows[2], &particles, &foreground });
+        }
+        else
+        {
+            build({ &background, &particles, &foreground });
+        }
+        frame();
+    }
+    const int planned = frames;
+    const int recreates = static_cast<int>(planner.Recreates);
+
+    // Lists change order, one disappears and comes back
+    build({ &foreground, &background, &particles });
+    frame();
+    build({ &background, &foreground });
+    frame();
+    build({ &particles, &background, &foreground });
+    frame();
+    const bool reorderReused = !plan.Lists[1].Upload && !plan.Lists[2].Upload;
+
+    // Device reset
+    planner.Invalidate();
+    frame();
+    const bool invalidateRecreates = plan.Recreate && plan.Discard && plan.UploadedLists == data.CmdListsCount;
+
+    printf("  %-28s %12.2f MB\n", "uploaded", planner.UploadedBytes / (1024.0 * 1024.0));
+    printf("  %-28s %12.2f MB\n", "full copy every frame", fullCopyBytes / (1024.0 * 1024.0));
+    printf("  %-28s %12d of %d frames\n", "background list skipped", backgroundReused, frames);
+    printf("  %-28s %12d (+5000/+10000 growth: %d)\n", "buffer recreations", recreates, oldSchemeReallocs);
+    printf("  %-28s %12llu\n", "ring wraps (discards)", static_cast<unsigned long long>(planner.Discards));
+    printf("  %-28s %12.0f ns\n", "plan per frame", planNs / frames);
+
+    check("every list reads back its own data", placedCorrectly);
+    check("previous frame's data never overwritten", inFlightUntouched);
+    check("ring wrapped and grew", planner.Discards > 0 && planner.Recreates > 1);
+    check("fewer recreations than +5000/+10000", recreates < oldSchemeReallocs);
+    check("static background skipped on most frames", backgroundReused > planned / 2);
+    check("uploads less than a full copy", planner.UploadedBytes < fullCopyBytes / 2);
+    check("reordered lists keep their data", reorderReused);
+    check("invalidate recreates and uploads all", invalidateRecreates);
+    return check.Result();
+}